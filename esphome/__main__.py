@@ -113,9 +113,22 @@ def get_port_type(port):
     return "NETWORK"
 
 
+def _load_firmware_strings(config):
+    from esphome import platformio_api
+    from esphome.components.logger import binary_log
+
+    try:
+        elf_path = platformio_api.get_idedata(config).firmware_elf_path
+        return binary_log.FirmwareStrings(elf_path)
+    except (OSError, ValueError, EsphomeError) as err:
+        _LOGGER.error("Can't decode binary log records: %s", err)
+        return False
+
+
 def run_miniterm(config, port):
     import serial
     from esphome import platformio_api
+    from esphome.components.logger import binary_log
 
     if CONF_LOGGER not in config:
         _LOGGER.info("Logger is not enabled. Not starting UART logs.")
@@ -127,6 +140,7 @@ def run_miniterm(config, port):
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
     backtrace_state = False
+    firmware_strings = None
     ser = serial.Serial()
     ser.baudrate = baud_rate
     ser.port = port
@@ -152,6 +166,11 @@ def run_miniterm(config, port):
                         .replace(b"\n", b"")
                         .decode("utf8", "backslashreplace")
                     )
+                    if line.startswith(binary_log.RECORD_MARKER):
+                        if firmware_strings is None:
+                            firmware_strings = _load_firmware_strings(config)
+                        if firmware_strings:
+                            line = binary_log.decode_record_line(line, firmware_strings)
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
@@ -60,10 +60,6 @@ void AlarmControlPanel::publish_state(AlarmControlPanelState state) {
   }
 }
 
-void AlarmControlPanel::add_on_state_callback(std::function<void()> &&callback) {
-  this->state_callback_.add(std::move(callback));
-}
-
 void AlarmControlPanel::add_on_triggered_callback(std::function<void()> &&callback) {
   this->triggered_callback_.add(std::move(callback));
 }
@@ -1,6 +1,8 @@
 #include "api_connection.h"
+#include <algorithm>
 #include <cerrno>
 #include <cinttypes>
+#include <cmath>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/entity_base.h"
@@ -20,6 +22,12 @@
 #ifdef USE_VOICE_ASSISTANT
 #include "esphome/components/voice_assistant/voice_assistant.h"
 #endif
+#ifdef USE_PROFILER
+#include "esphome/components/profiler/profiler.h"
+#endif
+#ifdef USE_LOGGER_HISTORY
+#include "esphome/components/logger/logger.h"
+#endif
 
 namespace esphome {
 namespace api {
@@ -30,6 +38,11 @@ static const int ESP32_CAMERA_STOP_STREAM = 5000;
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
   this->proto_write_buffer_.reserve(64);
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // wake the main loop as soon as the client sends something
+  this->socket_fd_ = sock->get_fd();
+  App.register_socket_fd(this->socket_fd_);
+#endif
 
 #if defined(USE_API_PLAINTEXT)
   this->helper_ = std::unique_ptr<APIFrameHelper>{new APIPlaintextFrameHelper(std::move(sock))};
@@ -38,6 +51,8 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #else
 #error "No frame helper defined"
 #endif
+  // messages sent during one loop are written to the socket together, see flush_batch_()
+  this->helper_->set_tx_batching(true);
 }
 void APIConnection::start() {
   this->last_traffic_ = millis();
@@ -55,6 +70,9 @@ void APIConnection::start() {
 }
 
 APIConnection::~APIConnection() {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  App.unregister_socket_fd(this->socket_fd_);
+#endif
 #ifdef USE_BLUETOOTH_PROXY
   if (bluetooth_proxy::global_bluetooth_proxy->get_api_connection() == this) {
     bluetooth_proxy::global_bluetooth_proxy->unsubscribe_api_connection(this);
@@ -80,6 +98,7 @@ void APIConnection::loop() {
   }
   if (this->next_close_) {
     // requested a disconnect
+    this->helper_->flush();
     this->helper_->close();
     this->remove_ = true;
     return;
@@ -135,7 +154,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // fixed32 key, bytes data and bool done, each with a tag (and a length for data)
+    auto buffer = this->create_buffer(5 + 3 + to_send + 2);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -168,7 +188,147 @@ void APIConnection::loop() {
       }
     }
   }
+
+#ifdef USE_PROFILER
+  if (this->profiler_stats_at_ != -1)
+    this->send_profiler_stats_();
+#endif
+#ifdef USE_LOGGER_HISTORY
+  if (this->log_history_at_ != -1)
+    this->send_log_history_();
+#endif
+#ifdef USE_SENSOR_HISTORY
+  if (this->sensor_history_at_ != -1)
+    this->send_sensor_history_();
+#endif
+
+  if (this->pending_states_ != 0)
+    this->flush_pending_states_();
+
+  if (this->batch_pending_ && millis() - this->batch_started_ >= this->parent_->get_batch_delay())
+    this->flush_batch_();
 }
+void APIConnection::flush_batch_() {
+  APIError err = this->helper_->flush();
+  if (err != APIError::OK) {
+    this->batch_pending_ = false;
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
+             api_error_to_str(err), errno);
+    return;
+  }
+  // After a partial write the rest stays pending and is retried on the next loop(), instead of waiting for the next
+  // message (which may only be the keepalive)
+  this->batch_pending_ = this->helper_->has_pending_tx();
+}
+
+#ifdef USE_PROFILER
+void APIConnection::send_profiler_stats_() {
+  auto *prof = profiler::global_profiler;
+  // send as many entries as fit in the socket buffer, continue in the next loop()
+  while (this->profiler_stats_at_ < (int) prof->size()) {
+    const profiler::ProfileStats &stats = prof->get(this->profiler_stats_at_);
+    ProfilerStatsResponse resp;
+    resp.component = stats.get_component_source();
+    resp.instance = stats.instance;
+    resp.section = static_cast<enums::ProfilerSection>(stats.section);
+    resp.name = stats.name;
+    resp.count = stats.count;
+    resp.total_us = stats.total_us;
+    resp.max_us = stats.max_us;
+    resp.p99_us = stats.percentile(99);
+    if (!this->send_profiler_stats_response(resp))
+      return;
+    this->profiler_stats_at_++;
+  }
+
+  ProfilerStatsDoneResponse done;
+  done.duration_ms = prof->get_duration();
+  if (!this->send_profiler_stats_done_response(done))
+    return;
+  if (this->profiler_stats_reset_)
+    prof->reset();
+  this->profiler_stats_at_ = -1;
+}
+#endif
+
+#ifdef USE_LOGGER_HISTORY
+static const size_t LOG_HISTORY_CHUNK_SIZE = 512;
+
+void APIConnection::log_history(const LogHistoryRequest &msg) {
+  logger::LogHistory &history = logger::global_logger->get_history();
+  if (msg.clear) {
+    // only answer with the done message
+    history.clear_previous();
+    this->log_history_.clear();
+  } else {
+    this->log_history_ = msg.current_boot ? history.get_current() : history.get_previous();
+  }
+  this->log_history_at_ = 0;
+}
+
+void APIConnection::send_log_history_() {
+  // send as many chunks as fit in the socket buffer, continue in the next loop()
+  while (true) {
+    LogHistoryResponse resp;
+    resp.data = this->log_history_.substr(this->log_history_at_, LOG_HISTORY_CHUNK_SIZE);
+    resp.done = this->log_history_at_ + resp.data.size() >= this->log_history_.size();
+    if (resp.done)
+      resp.reset_reason = logger::global_logger->get_history().get_reset_reason();
+    if (!this->send_log_history_response(resp))
+      return;
+    if (resp.done)
+      break;
+    this->log_history_at_ += resp.data.size();
+  }
+  this->log_history_.clear();
+  this->log_history_.shrink_to_fit();
+  this->log_history_at_ = -1;
+}
+#endif
+
+#ifdef USE_SENSOR_HISTORY
+static const size_t SENSOR_HISTORY_CHUNK_SIZE = 32;
+
+void APIConnection::sensor_history(const SensorHistoryRequest &msg) {
+  this->sensor_history_request_ = msg;
+  this->sensor_history_.clear();
+  sensor::Sensor *sensor = App.get_sensor_by_key(msg.key);
+  if (sensor != nullptr && sensor->get_history() != nullptr) {
+    this->sensor_history_ = sensor->get_history()->query(
+        static_cast<sensor::SensorHistoryResolution>(msg.resolution), msg.max_age_ms);
+  }
+  this->sensor_history_at_ = 0;
+}
+
+void APIConnection::send_sensor_history_() {
+  // send as many chunks as fit in the socket buffer, continue in the next loop()
+  while (true) {
+    SensorHistoryResponse resp;
+    resp.key = this->sensor_history_request_.key;
+    resp.resolution = this->sensor_history_request_.resolution;
+    const size_t end = std::min(this->sensor_history_at_ + SENSOR_HISTORY_CHUNK_SIZE, this->sensor_history_.size());
+    for (size_t i = this->sensor_history_at_; i < end; i++) {
+      const sensor::SensorHistoryPoint &point = this->sensor_history_[i];
+      SensorHistoryPoint resp_point;
+      resp_point.age_ms = point.age_ms;
+      resp_point.mean = point.mean;
+      resp_point.min = point.min;
+      resp_point.max = point.max;
+      resp.points.push_back(resp_point);
+    }
+    resp.done = end == this->sensor_history_.size();
+    if (!this->send_sensor_history_response(resp))
+      return;
+    if (resp.done)
+      break;
+    this->sensor_history_at_ = end;
+  }
+  this->sensor_history_.clear();
+  this->sensor_history_.shrink_to_fit();
+  this->sensor_history_at_ = -1;
+}
+#endif
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
@@ -191,12 +351,15 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_binary_sensor_state_response(make_binary_sensor_state_response(binary_sensor, state));
+}
+BinarySensorStateResponse APIConnection::make_binary_sensor_state_response(binary_sensor::BinarySensor *binary_sensor,
+                                                                           bool state) {
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -218,7 +381,9 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_cover_state_response(make_cover_state_response(cover));
+}
+CoverStateResponse APIConnection::make_cover_state_response(cover::Cover *cover) {
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
   resp.key = cover->get_object_id_hash();
@@ -228,7 +393,7 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -281,7 +446,9 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::Fan *fan) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_fan_state_response(make_fan_state_response(fan));
+}
+FanStateResponse APIConnection::make_fan_state_response(fan::Fan *fan) {
   auto traits = fan->get_traits();
   FanStateResponse resp{};
   resp.key = fan->get_object_id_hash();
@@ -293,7 +460,7 @@ bool APIConnection::send_fan_state(fan::Fan *fan) {
   }
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
@@ -336,7 +503,9 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_light_state_response(make_light_state_response(light));
+}
+LightStateResponse APIConnection::make_light_state_response(light::LightState *light) {
   auto traits = light->get_traits();
   auto values = light->remote_values;
   auto color_mode = values.get_color_mode();
@@ -356,7 +525,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -434,12 +603,14 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_sensor_state_response(make_sensor_state_response(sensor, state));
+}
+SensorStateResponse APIConnection::make_sensor_state_response(sensor::Sensor *sensor, float state) {
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -466,11 +637,13 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_switch_state_response(make_switch_state_response(a_switch, state));
+}
+SwitchStateResponse APIConnection::make_switch_state_response(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -503,12 +676,15 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_text_sensor_state_response(make_text_sensor_state_response(text_sensor, std::move(state)));
+}
+TextSensorStateResponse APIConnection::make_text_sensor_state_response(text_sensor::TextSensor *text_sensor,
+                                                                       std::string state) {
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -529,7 +705,9 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_climate_state_response(make_climate_state_response(climate));
+}
+ClimateStateResponse APIConnection::make_climate_state_response(climate::Climate *climate) {
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
   resp.key = climate->get_object_id_hash();
@@ -554,7 +732,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.custom_preset = climate->custom_preset.value();
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -627,12 +805,14 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 bool APIConnection::send_number_state(number::Number *number, float state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_number_state_response(make_number_state_response(number, state));
+}
+NumberStateResponse APIConnection::make_number_state_response(number::Number *number, float state) {
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
@@ -669,12 +849,14 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 bool APIConnection::send_text_state(text::Text *text, std::string state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_text_state_response(make_text_state_response(text, std::move(state)));
+}
+TextStateResponse APIConnection::make_text_state_response(text::Text *text, std::string state) {
   TextStateResponse resp{};
   resp.key = text->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text->has_state();
-  return this->send_text_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_text_info(text::Text *text) {
   ListEntitiesTextResponse msg;
@@ -707,12 +889,14 @@ void APIConnection::text_command(const TextCommandRequest &msg) {
 bool APIConnection::send_select_state(select::Select *select, std::string state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_select_state_response(make_select_state_response(select, std::move(state)));
+}
+SelectStateResponse APIConnection::make_select_state_response(select::Select *select, std::string state) {
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
@@ -768,11 +952,13 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_lock_state_response(make_lock_state_response(a_lock, state));
+}
+LockStateResponse APIConnection::make_lock_state_response(lock::Lock *a_lock, lock::LockState state) {
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
   resp.state = static_cast<enums::LockState>(state);
-  return this->send_lock_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
@@ -812,13 +998,15 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
 bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_media_player_state_response(make_media_player_state_response(media_player));
+}
+MediaPlayerStateResponse APIConnection::make_media_player_state_response(media_player::MediaPlayer *media_player) {
   MediaPlayerStateResponse resp{};
   resp.key = media_player->get_object_id_hash();
   resp.state = static_cast<enums::MediaPlayerState>(media_player->state);
   resp.volume = media_player->volume;
   resp.muted = media_player->is_muted();
-  return this->send_media_player_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
@@ -992,11 +1180,14 @@ void APIConnection::on_voice_assistant_event_response(const VoiceAssistantEventR
 bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_alarm_control_panel_state_response(make_alarm_control_panel_state_response(a_alarm_control_panel));
+}
+AlarmControlPanelStateResponse APIConnection::make_alarm_control_panel_state_response(
+    alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   AlarmControlPanelStateResponse resp{};
   resp.key = a_alarm_control_panel->get_object_id_hash();
   resp.state = static_cast<enums::AlarmControlPanelState>(a_alarm_control_panel->get_state());
-  return this->send_alarm_control_panel_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   ListEntitiesAlarmControlPanelResponse msg;
@@ -1051,11 +1242,13 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  const size_t line_len = strlen(line);
+  // level and message, each with a tag (and a length for the message)
+  auto buffer = this->create_buffer(2 + 1 + ProtoSize::varint(static_cast<uint32_t>(line_len)) + line_len);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_len);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -1140,7 +1333,7 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
 void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
   for (auto &it : this->parent_->get_state_subs()) {
     if (it.entity_id == msg.entity_id && it.attribute.value() == msg.attribute) {
-      it.callback(msg.state);
+      it.callback(msg.state.str());
     }
   }
 }
@@ -1155,10 +1348,100 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
     ESP_LOGV(TAG, "Could not find matching service!");
   }
 }
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  // the filter for STATE_ENTITY_TYPE_ALL is the default of the entity types without their own filter
+  StateFilter all{};
+  for (const auto &it : msg.filters) {
+    if (it.entity_type == enums::STATE_ENTITY_TYPE_ALL)
+      all = StateFilter{it.min_interval, it.deadband};
+  }
+  for (auto &filter : this->state_filters_)
+    filter = all;
+  for (const auto &it : msg.filters) {
+    if (it.entity_type != enums::STATE_ENTITY_TYPE_ALL && it.entity_type < STATE_ENTITY_TYPE_COUNT)
+      this->state_filters_[it.entity_type] = StateFilter{it.min_interval, it.deadband};
+  }
+  this->filtered_states_.clear();
+  this->pending_states_ = 0;
+  this->initial_state_iterator_.begin();
+}
+void APIConnection::send_shared_state(enums::StateEntityType entity_type, uint32_t key, optional<float> value,
+                                      const std::vector<uint8_t> &payload, uint16_t message_type) {
+  const StateFilter &filter = this->state_filters_[entity_type];
+  if (filter.min_interval == 0 && filter.deadband == 0.0f) {
+    this->send_shared_payload(payload, message_type);
+    return;
+  }
+
+  FilteredState &state = this->filtered_states_[{entity_type, key}];
+  state.entity_type = entity_type;
+  if (state.sent && (state.last_payload == payload || this->in_deadband_(filter, state, value))) {
+    // the client already has this state, a newer state waiting for the interval is obsolete as well
+    this->clear_pending_state_(state);
+    return;
+  }
+
+  // only the latest state is kept while waiting for the interval to pass
+  if (state.pending_type == 0)
+    this->pending_states_++;
+  state.pending_type = message_type;
+  state.pending_payload = payload;
+  state.pending_value = value;
+
+  const uint32_t now = millis();
+  if (!state.sent || now - state.last_sent >= filter.min_interval)
+    this->send_pending_state_(state, now);
+}
+bool APIConnection::in_deadband_(const StateFilter &filter, const FilteredState &state, optional<float> value) const {
+  if (filter.deadband == 0.0f || !value.has_value() || !state.last_value.has_value())
+    return false;
+  if (std::isnan(*value) || std::isnan(*state.last_value))
+    return false;
+  return std::fabs(*value - *state.last_value) < filter.deadband;
+}
+void APIConnection::clear_pending_state_(FilteredState &state) {
+  if (state.pending_type == 0)
+    return;
+  state.pending_type = 0;
+  state.pending_payload.clear();
+  this->pending_states_--;
+}
+bool APIConnection::send_pending_state_(FilteredState &state, uint32_t now) {
+  // stays pending when the socket buffer is full, so it is retried from loop()
+  if (!this->send_shared_payload(state.pending_payload, state.pending_type))
+    return false;
+  state.sent = true;
+  state.last_sent = now;
+  state.last_value = state.pending_value;
+  state.last_payload.swap(state.pending_payload);
+  this->clear_pending_state_(state);
+  return true;
+}
+void APIConnection::flush_pending_states_() {
+  const uint32_t now = millis();
+  for (auto &it : this->filtered_states_) {
+    FilteredState &state = it.second;
+    if (state.pending_type == 0 || now - state.last_sent < this->state_filters_[state.entity_type].min_interval)
+      continue;
+    if (!this->send_pending_state_(state, now))
+      return;
+  }
+}
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
+  if (!this->prepare_write_(message_type))
+    return false;
+  return this->check_write_result_(this->helper_->write_protobuf_packet(message_type, buffer));
+}
+bool APIConnection::send_shared_payload(const std::vector<uint8_t> &payload, uint32_t message_type) {
+  if (!this->prepare_write_(message_type))
+    return false;
+  return this->check_write_result_(this->helper_->write_packet(message_type, payload.data(), payload.size()));
+}
+bool APIConnection::prepare_write_(uint32_t message_type) {
   if (this->remove_)
     return false;
   if (!this->helper_->can_write_without_blocking()) {
@@ -1179,8 +1462,9 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
       return false;
     }
   }
-
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  return true;
+}
+bool APIConnection::check_write_result_(APIError err) {
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -1193,6 +1477,10 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
+  if (!this->batch_pending_) {
+    this->batch_pending_ = true;
+    this->batch_started_ = millis();
+  }
   // Do not set last_traffic_ on send
   return true;
 }
@@ -8,11 +8,15 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace esphome {
 namespace api {
 
+static const uint8_t STATE_ENTITY_TYPE_COUNT = enums::STATE_ENTITY_TYPE_ALARM_CONTROL_PANEL + 1;
+
 class APIConnection : public APIServerConnection {
  public:
   APIConnection(std::unique_ptr<socket::Socket> socket, APIServer *parent);
@@ -27,34 +31,43 @@ class APIConnection : public APIServerConnection {
   }
 #ifdef USE_BINARY_SENSOR
   bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  static BinarySensorStateResponse make_binary_sensor_state_response(binary_sensor::BinarySensor *binary_sensor,
+                                                                     bool state);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
 #endif
 #ifdef USE_COVER
   bool send_cover_state(cover::Cover *cover);
+  static CoverStateResponse make_cover_state_response(cover::Cover *cover);
   bool send_cover_info(cover::Cover *cover);
   void cover_command(const CoverCommandRequest &msg) override;
 #endif
 #ifdef USE_FAN
   bool send_fan_state(fan::Fan *fan);
+  static FanStateResponse make_fan_state_response(fan::Fan *fan);
   bool send_fan_info(fan::Fan *fan);
   void fan_command(const FanCommandRequest &msg) override;
 #endif
 #ifdef USE_LIGHT
   bool send_light_state(light::LightState *light);
+  static LightStateResponse make_light_state_response(light::LightState *light);
   bool send_light_info(light::LightState *light);
   void light_command(const LightCommandRequest &msg) override;
 #endif
 #ifdef USE_SENSOR
   bool send_sensor_state(sensor::Sensor *sensor, float state);
+  static SensorStateResponse make_sensor_state_response(sensor::Sensor *sensor, float state);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
 #ifdef USE_SWITCH
   bool send_switch_state(switch_::Switch *a_switch, bool state);
+  static SwitchStateResponse make_switch_state_response(switch_::Switch *a_switch, bool state);
   bool send_switch_info(switch_::Switch *a_switch);
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
   bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  static TextSensorStateResponse make_text_sensor_state_response(text_sensor::TextSensor *text_sensor,
+                                                                 std::string state);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -64,21 +77,25 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_CLIMATE
   bool send_climate_state(climate::Climate *climate);
+  static ClimateStateResponse make_climate_state_response(climate::Climate *climate);
   bool send_climate_info(climate::Climate *climate);
   void climate_command(const ClimateCommandRequest &msg) override;
 #endif
 #ifdef USE_NUMBER
   bool send_number_state(number::Number *number, float state);
+  static NumberStateResponse make_number_state_response(number::Number *number, float state);
   bool send_number_info(number::Number *number);
   void number_command(const NumberCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT
   bool send_text_state(text::Text *text, std::string state);
+  static TextStateResponse make_text_state_response(text::Text *text, std::string state);
   bool send_text_info(text::Text *text);
   void text_command(const TextCommandRequest &msg) override;
 #endif
 #ifdef USE_SELECT
   bool send_select_state(select::Select *select, std::string state);
+  static SelectStateResponse make_select_state_response(select::Select *select, std::string state);
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
@@ -88,11 +105,13 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_LOCK
   bool send_lock_state(lock::Lock *a_lock, lock::LockState state);
+  static LockStateResponse make_lock_state_response(lock::Lock *a_lock, lock::LockState state);
   bool send_lock_info(lock::Lock *a_lock);
   void lock_command(const LockCommandRequest &msg) override;
 #endif
 #ifdef USE_MEDIA_PLAYER
   bool send_media_player_state(media_player::MediaPlayer *media_player);
+  static MediaPlayerStateResponse make_media_player_state_response(media_player::MediaPlayer *media_player);
   bool send_media_player_info(media_player::MediaPlayer *media_player);
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
@@ -133,6 +152,8 @@ class APIConnection : public APIServerConnection {
 
 #ifdef USE_ALARM_CONTROL_PANEL
   bool send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
+  static AlarmControlPanelStateResponse make_alarm_control_panel_state_response(
+      alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   bool send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) override;
 #endif
@@ -152,12 +173,10 @@ class APIConnection : public APIServerConnection {
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+    this->parent_->forward_logs();
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -170,6 +189,18 @@ class APIConnection : public APIServerConnection {
     return {};
   }
   void execute_service(const ExecuteServiceRequest &msg) override;
+#ifdef USE_PROFILER
+  void profiler_stats(const ProfilerStatsRequest &msg) override {
+    this->profiler_stats_at_ = 0;
+    this->profiler_stats_reset_ = msg.reset;
+  }
+#endif
+#ifdef USE_LOGGER_HISTORY
+  void log_history(const LogHistoryRequest &msg) override;
+#endif
+#ifdef USE_SENSOR_HISTORY
+  void sensor_history(const SensorHistoryRequest &msg) override;
+#endif
 
   bool is_authenticated() override { return this->connection_state_ == ConnectionState::AUTHENTICATED; }
   bool is_connection_setup() override {
@@ -178,12 +209,24 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
+    // reserve room for the frame header so the helper can assemble (and encrypt) the frame in place
     this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(this->helper_->frame_header_padding() + reserve_size);
+    this->proto_write_buffer_.resize(this->helper_->frame_header_padding());
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
+  /// Send a payload that is shared with other connections (without reserved frame header bytes), it is not modified.
+  bool send_shared_payload(const std::vector<uint8_t> &payload, uint32_t message_type);
+  /** Send a state update that is shared with other connections, applying the filters of the state subscription.
+   *
+   * @param key The key of the entity the state belongs to.
+   * @param value The numeric state the deadband applies to, empty for non-numeric states.
+   */
+  void send_shared_state(enums::StateEntityType entity_type, uint32_t key, optional<float> value,
+                         const std::vector<uint8_t> &payload, uint16_t message_type);
 
   std::string get_client_combined_info() const { return this->client_combined_info_; }
 
@@ -191,6 +234,39 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  bool prepare_write_(uint32_t message_type);
+  bool check_write_result_(APIError err);
+  void flush_batch_();
+
+  struct StateFilter {
+    uint32_t min_interval{0};
+    float deadband{0.0f};
+  };
+  /// Last sent (and pending) state of an entity, only tracked for entity types with a filter.
+  struct FilteredState {
+    enums::StateEntityType entity_type;
+    bool sent{false};
+    /// Message type of the state waiting for min_interval to pass, 0 if none.
+    uint16_t pending_type{0};
+    uint32_t last_sent{0};
+    optional<float> last_value;
+    optional<float> pending_value;
+    std::vector<uint8_t> last_payload;
+    std::vector<uint8_t> pending_payload;
+  };
+  bool in_deadband_(const StateFilter &filter, const FilteredState &state, optional<float> value) const;
+  void clear_pending_state_(FilteredState &state);
+  bool send_pending_state_(FilteredState &state, uint32_t now);
+  void flush_pending_states_();
+#ifdef USE_PROFILER
+  void send_profiler_stats_();
+#endif
+#ifdef USE_LOGGER_HISTORY
+  void send_log_history_();
+#endif
+#ifdef USE_SENSOR_HISTORY
+  void send_sensor_history_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -199,11 +275,17 @@ class APIConnection : public APIServerConnection {
   } connection_state_{ConnectionState::WAITING_FOR_HELLO};
 
   bool remove_{false};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  int socket_fd_{-1};
+#endif
 
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
   std::unique_ptr<APIFrameHelper> helper_;
+  /// Whether messages are held back in the frame helper, and since when.
+  bool batch_pending_{false};
+  uint32_t batch_started_{0};
 
   std::string client_info_;
   std::string client_peername_;
@@ -215,6 +297,10 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  StateFilter state_filters_[STATE_ENTITY_TYPE_COUNT];
+  /// Keyed by entity type and key, keys are object ID hashes and repeat across entity types.
+  std::map<std::pair<enums::StateEntityType, uint32_t>, FilteredState> filtered_states_;
+  uint16_t pending_states_{0};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
   bool sent_ping_{false};
@@ -224,6 +310,21 @@ class APIConnection : public APIServerConnection {
   InitialStateIterator initial_state_iterator_;
   ListEntitiesIterator list_entities_iterator_;
   int state_subs_at_ = -1;
+#ifdef USE_PROFILER
+  int profiler_stats_at_ = -1;
+  bool profiler_stats_reset_{false};
+#endif
+#ifdef USE_LOGGER_HISTORY
+  /// Copy of the requested history, sent in chunks from loop().
+  std::string log_history_;
+  int log_history_at_ = -1;
+#endif
+#ifdef USE_SENSOR_HISTORY
+  /// The requested points, sent in chunks from loop().
+  std::vector<sensor::SensorHistoryPoint> sensor_history_;
+  SensorHistoryRequest sensor_history_request_;
+  int sensor_history_at_ = -1;
+#endif
 };
 
 }  // namespace api
@@ -12,6 +12,9 @@ namespace api {
 
 static const char *const TAG = "api.socket";
 
+/// Pending data size at which batched packets are written without waiting for flush(), about one TCP segment.
+static const size_t TX_BATCH_SIZE = 1436;
+
 /// Is the given return value (from write syscalls) a wouldblock error?
 bool is_would_block(ssize_t ret) {
   if (ret == -1) {
@@ -72,6 +75,48 @@ const char *api_error_to_str(APIError err) {
   return "UNKNOWN";
 }
 
+void TxRingBuffer::push(const uint8_t *data, size_t len) {
+  if (this->size_ + len > this->capacity_) {
+    size_t capacity = this->capacity_ == 0 ? 64 : this->capacity_;
+    while (capacity < this->size_ + len)
+      capacity *= 2;
+    // move the pending data to the start of the new storage
+    std::unique_ptr<uint8_t[]> grown{new uint8_t[capacity]};
+    struct iovec iov[2];
+    int iovcnt = this->peek(iov);
+    size_t pos = 0;
+    for (int i = 0; i < iovcnt; i++) {
+      memcpy(&grown[pos], iov[i].iov_base, iov[i].iov_len);
+      pos += iov[i].iov_len;
+    }
+    this->data_ = std::move(grown);
+    this->capacity_ = capacity;
+    this->head_ = 0;
+  }
+  const size_t tail = (this->head_ + this->size_) & (this->capacity_ - 1);
+  const size_t first = std::min(len, this->capacity_ - tail);
+  memcpy(&this->data_[tail], data, first);
+  memcpy(&this->data_[0], data + first, len - first);
+  this->size_ += len;
+}
+int TxRingBuffer::peek(struct iovec *iov) const {
+  if (this->size_ == 0)
+    return 0;
+  const size_t first = std::min(this->size_, this->capacity_ - this->head_);
+  iov[0].iov_base = &this->data_[this->head_];
+  iov[0].iov_len = first;
+  if (first == this->size_)
+    return 1;
+  iov[1].iov_base = &this->data_[0];
+  iov[1].iov_len = this->size_ - first;
+  return 2;
+}
+void TxRingBuffer::consume(size_t len) {
+  this->size_ -= len;
+  // start over at the beginning once drained, so the next pending data is contiguous
+  this->head_ = this->size_ == 0 ? 0 : (this->head_ + len) & (this->capacity_ - 1);
+}
+
 #define HELPER_LOG(msg, ...) ESP_LOGVV(TAG, "%s: " msg, info_.c_str(), ##__VA_ARGS__)
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
@@ -152,7 +197,8 @@ APIError APINoiseFrameHelper::loop() {
     return APIError::OK;
   if (err != APIError::OK)
     return err;
-  if (!tx_buf_.empty()) {
+  // try send pending TX data, packets held back for batching wait for flush()
+  if (!tx_buf_.empty() && !can_write_without_blocking()) {
     err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -466,8 +512,21 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = type;
   return APIError::OK;
 }
-bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APINoiseFrameHelper::can_write_without_blocking() {
+  // data held back for batching does not block, as long as it stays below a segment
+  return state_ == State::DATA && (tx_buf_.empty() || (tx_batching_ && tx_buf_.size() < TX_BATCH_SIZE));
+}
+APIError APINoiseFrameHelper::flush() {
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
 APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+  tx_packet_buf_.resize(frame_header_padding_);
+  tx_packet_buf_.insert(tx_packet_buf_.end(), payload, payload + payload_len);
+  return write_protobuf_packet(type, ProtoWriteBuffer{&tx_packet_buf_});
+}
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,31 +538,25 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
+  size_t msg_len = 4 + payload_len;
+  // make room for the MAC behind the payload
+  raw_buffer->resize(raw_buffer->size() + noise_cipherstate_get_mac_length(send_cipher_));
+  uint8_t *frame = raw_buffer->data();
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  frame[0] = 0x01;  // indicator
+  // frame[1], frame[2] to be set later
   const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  frame[msg_offset + 0] = (uint8_t) (type >> 8);  // type
+  frame[msg_offset + 1] = (uint8_t) type;
+  frame[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
+  frame[msg_offset + 3] = (uint8_t) payload_len;
 
+  // encrypt the message header and payload in place
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &frame[msg_offset], msg_len, raw_buffer->size() - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -512,11 +565,11 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  frame[1] = (uint8_t) (mbuf.size >> 8);
+  frame[2] = (uint8_t) mbuf.size;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = frame;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
@@ -525,7 +578,9 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[2];
+    int iovcnt = tx_buf_.peek(iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (sent == -1) {
       if (errno == EWOULDBLOCK || errno == EAGAIN)
         break;
@@ -535,9 +590,7 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
     } else if (sent == 0) {
       break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_.consume(sent);
   }
 
   return APIError::OK;
@@ -561,6 +614,16 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     total_write_len += iov[i].iov_len;
   }
 
+  if (tx_batching_ && state_ == State::DATA) {
+    // hold the packet back, it goes out with the next flush() or once about a full segment is pending
+    for (int i = 0; i < iovcnt; i++) {
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    if (tx_buf_.size() < TX_BATCH_SIZE)
+      return APIError::OK;
+    return try_send_tx_buf_();
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -571,8 +634,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -581,8 +643,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -597,8 +658,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume, iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
@@ -772,8 +832,8 @@ APIError APIPlaintextFrameHelper::loop() {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
-  // try send pending TX data
-  if (!tx_buf_.empty()) {
+  // try send pending TX data, packets held back for batching wait for flush()
+  if (!tx_buf_.empty() && !can_write_without_blocking()) {
     APIError err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -902,20 +962,31 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
-bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APIPlaintextFrameHelper::can_write_without_blocking() {
+  // data held back for batching does not block, as long as it stays below a segment
+  return state_ == State::DATA && (tx_buf_.empty() || (tx_batching_ && tx_buf_.size() < TX_BATCH_SIZE));
+}
+APIError APIPlaintextFrameHelper::flush() {
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
 APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  // indicator + varint data length + varint type
+  uint8_t header[1 + 10 + 10];
+  ProtoVarInt len_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  header[0] = 0x00;
+  len_varint.encode(&header[1]);
+  type_varint.encode(&header[1 + len_varint.encoded_size()]);
 
   struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
+  iov[0].iov_base = header;
+  iov[0].iov_len = 1 + len_varint.encoded_size() + type_varint.encoded_size();
   if (payload_len == 0) {
     return write_raw_(iov, 1);
   }
@@ -924,10 +995,37 @@ APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *pay
 
   return write_raw_(iov, 2);
 }
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
+  ProtoVarInt len_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  size_t header_len = 1 + len_varint.encoded_size() + type_varint.encoded_size();
+  if (header_len > frame_header_padding_) {
+    // header does not fit into the reserved bytes, send it separately
+    return write_packet(type, raw_buffer->data() + frame_header_padding_, payload_len);
+  }
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+
+  // the header is placed right in front of the payload, unused reserved bytes are skipped
+  uint8_t *header = raw_buffer->data() + frame_header_padding_ - header_len;
+  header[0] = 0x00;
+  len_varint.encode(&header[1]);
+  type_varint.encode(&header[1 + len_varint.encoded_size()]);
+
+  struct iovec iov;
+  iov.iov_base = header;
+  iov.iov_len = header_len + payload_len;
+  return write_raw_(&iov, 1);
+}
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[2];
+    int iovcnt = tx_buf_.peek(iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -935,9 +1033,7 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_.consume(sent);
   }
 
   return APIError::OK;
@@ -961,6 +1057,16 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     total_write_len += iov[i].iov_len;
   }
 
+  if (tx_batching_ && state_ == State::DATA) {
+    // hold the packet back, it goes out with the next flush() or once about a full segment is pending
+    for (int i = 0; i < iovcnt; i++) {
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    if (tx_buf_.size() < TX_BATCH_SIZE)
+      return APIError::OK;
+    return try_send_tx_buf_();
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -971,8 +1077,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   }
@@ -981,8 +1086,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
     for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+      tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
     }
     return APIError::OK;
   } else if (sent == -1) {
@@ -997,8 +1101,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
       if (to_consume >= iov[i].iov_len) {
         to_consume -= iov[i].iov_len;
       } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+        tx_buf_.push(reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume, iov[i].iov_len - to_consume);
         to_consume = 0;
       }
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #endif
 
 #include "api_noise_context.h"
+#include "proto.h"
 #include "esphome/components/socket/socket.h"
 
 namespace esphome {
@@ -58,6 +60,29 @@ enum class APIError : int {
 
 const char *api_error_to_str(APIError err);
 
+/** Byte ring buffer for data that could not be written to the socket yet.
+ *
+ * Consuming sent data only moves the read position, and the storage (always a power of two) only grows when more
+ * data is pending than fits.
+ */
+class TxRingBuffer {
+ public:
+  bool empty() const { return this->size_ == 0; }
+  size_t size() const { return this->size_; }
+  /// Append data, growing the storage if needed.
+  void push(const uint8_t *data, size_t len);
+  /// Fill `iov` with the (at most two) contiguous regions of pending data, returns the number of regions.
+  int peek(struct iovec *iov) const;
+  /// Drop `len` bytes from the front after they have been sent.
+  void consume(size_t len);
+
+ protected:
+  std::unique_ptr<uint8_t[]> data_;
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
 class APIFrameHelper {
  public:
   virtual ~APIFrameHelper() = default;
@@ -65,26 +90,54 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
+  /// Write a packet from a payload owned by the caller, the payload is not modified.
   virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Write a packet that was encoded into `buffer` behind frame_header_padding() reserved bytes.
+   *
+   * The frame header is written into the reserved bytes and the buffer may be extended at the end (for the MAC), so
+   * the frame is assembled and encrypted in place. The buffer contents are undefined afterwards.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /// Number of bytes to reserve in front of the payload passed to write_protobuf_packet().
+  uint8_t frame_header_padding() const { return this->frame_header_padding_; }
+  /** Hold back written packets until flush() is called (or about a full TCP segment is pending).
+   *
+   * Several small packets then go out in a single socket write instead of one write (and one segment) each.
+   */
+  void set_tx_batching(bool tx_batching) { this->tx_batching_ = tx_batching; }
+  /// Write all pending data (including packets held back for batching) to the socket, as far as it accepts it.
+  virtual APIError flush() = 0;
+  /// Whether written data is still waiting for the socket, e.g. after flush() could only write part of it.
+  virtual bool has_pending_tx() const = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+ protected:
+  uint8_t frame_header_padding_{0};
+  bool tx_batching_{false};
 };
 
 #ifdef USE_API_NOISE
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
-      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {}
+      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {
+    // 3 bytes frame header (indicator, encrypted size) + 4 bytes message header (type, data length)
+    this->frame_header_padding_ = 7;
+  }
   ~APINoiseFrameHelper() override;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError flush() override;
+  bool has_pending_tx() const override { return !this->tx_buf_.empty(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -116,7 +169,9 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  TxRingBuffer tx_buf_;
+  /// Frame assembly buffer for payloads passed to write_packet(), re-used to prevent allocations.
+  std::vector<uint8_t> tx_packet_buf_;
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -141,13 +196,19 @@ class APINoiseFrameHelper : public APIFrameHelper {
 #ifdef USE_API_PLAINTEXT
 class APIPlaintextFrameHelper : public APIFrameHelper {
  public:
-  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {}
+  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {
+    // indicator + varint data length (payloads up to 2MiB) + varint type (up to 16383)
+    this->frame_header_padding_ = 6;
+  }
   ~APIPlaintextFrameHelper() override = default;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError flush() override;
+  bool has_pending_tx() const override { return !this->tx_buf_.empty(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -177,7 +238,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  TxRingBuffer tx_buf_;
 
   enum class State {
     INITIALIZE = 1,
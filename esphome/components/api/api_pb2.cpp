@@ -8,6 +8,44 @@
 namespace esphome {
 namespace api {
 
+#ifdef HAS_PROTO_MESSAGE_DUMP
+template<> const char *proto_enum_to_string<enums::StateEntityType>(enums::StateEntityType value) {
+  switch (value) {
+    case enums::STATE_ENTITY_TYPE_ALL:
+      return "STATE_ENTITY_TYPE_ALL";
+    case enums::STATE_ENTITY_TYPE_BINARY_SENSOR:
+      return "STATE_ENTITY_TYPE_BINARY_SENSOR";
+    case enums::STATE_ENTITY_TYPE_COVER:
+      return "STATE_ENTITY_TYPE_COVER";
+    case enums::STATE_ENTITY_TYPE_FAN:
+      return "STATE_ENTITY_TYPE_FAN";
+    case enums::STATE_ENTITY_TYPE_LIGHT:
+      return "STATE_ENTITY_TYPE_LIGHT";
+    case enums::STATE_ENTITY_TYPE_SENSOR:
+      return "STATE_ENTITY_TYPE_SENSOR";
+    case enums::STATE_ENTITY_TYPE_SWITCH:
+      return "STATE_ENTITY_TYPE_SWITCH";
+    case enums::STATE_ENTITY_TYPE_TEXT_SENSOR:
+      return "STATE_ENTITY_TYPE_TEXT_SENSOR";
+    case enums::STATE_ENTITY_TYPE_CLIMATE:
+      return "STATE_ENTITY_TYPE_CLIMATE";
+    case enums::STATE_ENTITY_TYPE_NUMBER:
+      return "STATE_ENTITY_TYPE_NUMBER";
+    case enums::STATE_ENTITY_TYPE_TEXT:
+      return "STATE_ENTITY_TYPE_TEXT";
+    case enums::STATE_ENTITY_TYPE_SELECT:
+      return "STATE_ENTITY_TYPE_SELECT";
+    case enums::STATE_ENTITY_TYPE_LOCK:
+      return "STATE_ENTITY_TYPE_LOCK";
+    case enums::STATE_ENTITY_TYPE_MEDIA_PLAYER:
+      return "STATE_ENTITY_TYPE_MEDIA_PLAYER";
+    case enums::STATE_ENTITY_TYPE_ALARM_CONTROL_PANEL:
+      return "STATE_ENTITY_TYPE_ALARM_CONTROL_PANEL";
+    default:
+      return "UNKNOWN";
+  }
+}
+#endif
 #ifdef HAS_PROTO_MESSAGE_DUMP
 template<> const char *proto_enum_to_string<enums::EntityCategory>(enums::EntityCategory value) {
   switch (value) {
@@ -524,6 +562,36 @@ template<> const char *proto_enum_to_string<enums::TextMode>(enums::TextMode val
   }
 }
 #endif
+#ifdef HAS_PROTO_MESSAGE_DUMP
+template<> const char *proto_enum_to_string<enums::ProfilerSection>(enums::ProfilerSection value) {
+  switch (value) {
+    case enums::PROFILER_SECTION_SETUP:
+      return "PROFILER_SECTION_SETUP";
+    case enums::PROFILER_SECTION_LOOP:
+      return "PROFILER_SECTION_LOOP";
+    case enums::PROFILER_SECTION_TIMEOUT:
+      return "PROFILER_SECTION_TIMEOUT";
+    case enums::PROFILER_SECTION_INTERVAL:
+      return "PROFILER_SECTION_INTERVAL";
+    default:
+      return "UNKNOWN";
+  }
+}
+#endif
+#ifdef HAS_PROTO_MESSAGE_DUMP
+template<> const char *proto_enum_to_string<enums::SensorHistoryResolution>(enums::SensorHistoryResolution value) {
+  switch (value) {
+    case enums::SENSOR_HISTORY_RESOLUTION_RAW:
+      return "SENSOR_HISTORY_RESOLUTION_RAW";
+    case enums::SENSOR_HISTORY_RESOLUTION_MINUTE:
+      return "SENSOR_HISTORY_RESOLUTION_MINUTE";
+    case enums::SENSOR_HISTORY_RESOLUTION_HOUR:
+      return "SENSOR_HISTORY_RESOLUTION_HOUR";
+    default:
+      return "UNKNOWN";
+  }
+}
+#endif
 bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 2: {
@@ -553,6 +621,11 @@ void HelloRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->api_version_major);
   buffer.encode_uint32(3, this->api_version_minor);
 }
+void HelloRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->client_info);
+  ProtoSize::add_uint32(total_size, 2, this->api_version_major);
+  ProtoSize::add_uint32(total_size, 3, this->api_version_minor);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -607,6 +680,12 @@ void HelloResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->server_info);
   buffer.encode_string(4, this->name);
 }
+void HelloResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32(total_size, 2, this->api_version_minor);
+  ProtoSize::add_string(total_size, 3, this->server_info);
+  ProtoSize::add_string(total_size, 4, this->name);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -642,6 +721,9 @@ bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value
   }
 }
 void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -663,6 +745,9 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   }
 }
 void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->invalid_password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -674,22 +759,27 @@ void ConnectResponse::dump_to(std::string &out) const {
 }
 #endif
 void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 #endif
 void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 #endif
 void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 #endif
 void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 #endif
 void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
 #endif
@@ -787,6 +877,24 @@ void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(14, this->voice_assistant_version);
   buffer.encode_string(16, this->suggested_area);
 }
+void DeviceInfoResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->uses_password);
+  ProtoSize::add_string(total_size, 2, this->name);
+  ProtoSize::add_string(total_size, 3, this->mac_address);
+  ProtoSize::add_string(total_size, 4, this->esphome_version);
+  ProtoSize::add_string(total_size, 5, this->compilation_time);
+  ProtoSize::add_string(total_size, 6, this->model);
+  ProtoSize::add_bool(total_size, 7, this->has_deep_sleep);
+  ProtoSize::add_string(total_size, 8, this->project_name);
+  ProtoSize::add_string(total_size, 9, this->project_version);
+  ProtoSize::add_uint32(total_size, 10, this->webserver_port);
+  ProtoSize::add_uint32(total_size, 11, this->legacy_bluetooth_proxy_version);
+  ProtoSize::add_uint32(total_size, 15, this->bluetooth_proxy_feature_flags);
+  ProtoSize::add_string(total_size, 12, this->manufacturer);
+  ProtoSize::add_string(total_size, 13, this->friendly_name);
+  ProtoSize::add_uint32(total_size, 14, this->voice_assistant_version);
+  ProtoSize::add_string(total_size, 16, this->suggested_area);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -862,16 +970,101 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
 }
 #endif
 void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 #endif
 void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
-void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+bool SubscribeStatesFilter::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->entity_type = value.as_enum<enums::StateEntityType>();
+      return true;
+    }
+    case 2: {
+      this->min_interval = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeStatesFilter::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 3: {
+      this->deadband = value.as_float();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesFilter::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_enum<enums::StateEntityType>(1, this->entity_type);
+  buffer.encode_uint32(2, this->min_interval);
+  buffer.encode_float(3, this->deadband);
+}
+void SubscribeStatesFilter::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::StateEntityType>(total_size, 1, this->entity_type);
+  ProtoSize::add_uint32(total_size, 2, this->min_interval);
+  ProtoSize::add_float(total_size, 3, this->deadband);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SubscribeStatesFilter::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesFilter {\n");
+  out.append("  entity_type: ");
+  out.append(proto_enum_to_string<enums::StateEntityType>(this->entity_type));
+  out.append("\n");
+
+  out.append("  min_interval: ");
+  sprintf(buffer, "%" PRIu32, this->min_interval);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  deadband: ");
+  sprintf(buffer, "%g", this->deadband);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SubscribeStatesRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->filters.emplace_back();
+      value.decode_to_message(this->filters.back());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->filters) {
+    buffer.encode_message<SubscribeStatesFilter>(1, it, true);
+  }
+}
+void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->filters) {
+    ProtoSize::add_message<SubscribeStatesFilter>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
-void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
+void SubscribeStatesRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesRequest {\n");
+  for (const auto &it : this->filters) {
+    out.append("  filters: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
 #endif
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
@@ -938,6 +1131,17 @@ void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(8, this->icon);
   buffer.encode_enum<enums::EntityCategory>(9, this->entity_category);
 }
+void ListEntitiesBinarySensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->device_class);
+  ProtoSize::add_bool(total_size, 6, this->is_status_binary_sensor);
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 8, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 9, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesBinarySensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1010,6 +1214,11 @@ void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void BinarySensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BinarySensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1109,6 +1318,20 @@ void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
   buffer.encode_bool(12, this->supports_stop);
 }
+void ListEntitiesCoverResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->assumed_state);
+  ProtoSize::add_bool(total_size, 6, this->supports_position);
+  ProtoSize::add_bool(total_size, 7, this->supports_tilt);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 10, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 11, this->entity_category);
+  ProtoSize::add_bool(total_size, 12, this->supports_stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCoverResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1203,6 +1426,13 @@ void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(4, this->tilt);
   buffer.encode_enum<enums::CoverOperation>(5, this->current_operation);
 }
+void CoverStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LegacyCoverState>(total_size, 2, this->legacy_state);
+  ProtoSize::add_float(total_size, 3, this->position);
+  ProtoSize::add_float(total_size, 4, this->tilt);
+  ProtoSize::add_enum<enums::CoverOperation>(total_size, 5, this->current_operation);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1286,6 +1516,16 @@ void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(7, this->tilt);
   buffer.encode_bool(8, this->stop);
 }
+void CoverCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_legacy_command);
+  ProtoSize::add_enum<enums::LegacyCoverCommand>(total_size, 3, this->legacy_command);
+  ProtoSize::add_bool(total_size, 4, this->has_position);
+  ProtoSize::add_float(total_size, 5, this->position);
+  ProtoSize::add_bool(total_size, 6, this->has_tilt);
+  ProtoSize::add_float(total_size, 7, this->tilt);
+  ProtoSize::add_bool(total_size, 8, this->stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1402,6 +1642,19 @@ void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(10, this->icon);
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
 }
+void ListEntitiesFanResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->supports_oscillation);
+  ProtoSize::add_bool(total_size, 6, this->supports_speed);
+  ProtoSize::add_bool(total_size, 7, this->supports_direction);
+  ProtoSize::add_int32(total_size, 8, this->supported_speed_count);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 10, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 11, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesFanResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1498,6 +1751,14 @@ void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::FanDirection>(5, this->direction);
   buffer.encode_int32(6, this->speed_level);
 }
+void FanStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->oscillating);
+  ProtoSize::add_enum<enums::FanSpeed>(total_size, 4, this->speed);
+  ProtoSize::add_enum<enums::FanDirection>(total_size, 5, this->direction);
+  ProtoSize::add_int32(total_size, 6, this->speed_level);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1599,6 +1860,19 @@ void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->has_speed_level);
   buffer.encode_int32(11, this->speed_level);
 }
+void FanCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_state);
+  ProtoSize::add_bool(total_size, 3, this->state);
+  ProtoSize::add_bool(total_size, 4, this->has_speed);
+  ProtoSize::add_enum<enums::FanSpeed>(total_size, 5, this->speed);
+  ProtoSize::add_bool(total_size, 6, this->has_oscillating);
+  ProtoSize::add_bool(total_size, 7, this->oscillating);
+  ProtoSize::add_bool(total_size, 8, this->has_direction);
+  ProtoSize::add_enum<enums::FanDirection>(total_size, 9, this->direction);
+  ProtoSize::add_bool(total_size, 10, this->has_speed_level);
+  ProtoSize::add_int32(total_size, 11, this->speed_level);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1750,6 +2024,27 @@ void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(14, this->icon);
   buffer.encode_enum<enums::EntityCategory>(15, this->entity_category);
 }
+void ListEntitiesLightResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  for (const auto &it : this->supported_color_modes) {
+    ProtoSize::add_enum<enums::ColorMode>(total_size, 12, it, true);
+  }
+  ProtoSize::add_bool(total_size, 5, this->legacy_supports_brightness);
+  ProtoSize::add_bool(total_size, 6, this->legacy_supports_rgb);
+  ProtoSize::add_bool(total_size, 7, this->legacy_supports_white_value);
+  ProtoSize::add_bool(total_size, 8, this->legacy_supports_color_temperature);
+  ProtoSize::add_float(total_size, 9, this->min_mireds);
+  ProtoSize::add_float(total_size, 10, this->max_mireds);
+  for (const auto &it : this->effects) {
+    ProtoSize::add_string(total_size, 11, it, true);
+  }
+  ProtoSize::add_bool(total_size, 13, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 14, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 15, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLightResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1908,6 +2203,21 @@ void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(13, this->warm_white);
   buffer.encode_string(9, this->effect);
 }
+void LightStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_float(total_size, 3, this->brightness);
+  ProtoSize::add_enum<enums::ColorMode>(total_size, 11, this->color_mode);
+  ProtoSize::add_float(total_size, 10, this->color_brightness);
+  ProtoSize::add_float(total_size, 4, this->red);
+  ProtoSize::add_float(total_size, 5, this->green);
+  ProtoSize::add_float(total_size, 6, this->blue);
+  ProtoSize::add_float(total_size, 7, this->white);
+  ProtoSize::add_float(total_size, 8, this->color_temperature);
+  ProtoSize::add_float(total_size, 12, this->cold_white);
+  ProtoSize::add_float(total_size, 13, this->warm_white);
+  ProtoSize::add_string(total_size, 9, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2131,6 +2441,35 @@ void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(18, this->has_effect);
   buffer.encode_string(19, this->effect);
 }
+void LightCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_state);
+  ProtoSize::add_bool(total_size, 3, this->state);
+  ProtoSize::add_bool(total_size, 4, this->has_brightness);
+  ProtoSize::add_float(total_size, 5, this->brightness);
+  ProtoSize::add_bool(total_size, 22, this->has_color_mode);
+  ProtoSize::add_enum<enums::ColorMode>(total_size, 23, this->color_mode);
+  ProtoSize::add_bool(total_size, 20, this->has_color_brightness);
+  ProtoSize::add_float(total_size, 21, this->color_brightness);
+  ProtoSize::add_bool(total_size, 6, this->has_rgb);
+  ProtoSize::add_float(total_size, 7, this->red);
+  ProtoSize::add_float(total_size, 8, this->green);
+  ProtoSize::add_float(total_size, 9, this->blue);
+  ProtoSize::add_bool(total_size, 10, this->has_white);
+  ProtoSize::add_float(total_size, 11, this->white);
+  ProtoSize::add_bool(total_size, 12, this->has_color_temperature);
+  ProtoSize::add_float(total_size, 13, this->color_temperature);
+  ProtoSize::add_bool(total_size, 24, this->has_cold_white);
+  ProtoSize::add_float(total_size, 25, this->cold_white);
+  ProtoSize::add_bool(total_size, 26, this->has_warm_white);
+  ProtoSize::add_float(total_size, 27, this->warm_white);
+  ProtoSize::add_bool(total_size, 14, this->has_transition_length);
+  ProtoSize::add_uint32(total_size, 15, this->transition_length);
+  ProtoSize::add_bool(total_size, 16, this->has_flash_length);
+  ProtoSize::add_uint32(total_size, 17, this->flash_length);
+  ProtoSize::add_bool(total_size, 18, this->has_effect);
+  ProtoSize::add_string(total_size, 19, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2342,6 +2681,21 @@ void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(13, this->entity_category);
 }
+void ListEntitiesSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_string(total_size, 6, this->unit_of_measurement);
+  ProtoSize::add_int32(total_size, 7, this->accuracy_decimals);
+  ProtoSize::add_bool(total_size, 8, this->force_update);
+  ProtoSize::add_string(total_size, 9, this->device_class);
+  ProtoSize::add_enum<enums::SensorStateClass>(total_size, 10, this->state_class);
+  ProtoSize::add_enum<enums::SensorLastResetType>(total_size, 11, this->legacy_last_reset_type);
+  ProtoSize::add_bool(total_size, 12, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 13, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2431,6 +2785,11 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2516,6 +2875,17 @@ void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
   buffer.encode_string(9, this->device_class);
 }
+void ListEntitiesSwitchResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->assumed_state);
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 8, this->entity_category);
+  ProtoSize::add_string(total_size, 9, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSwitchResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2583,6 +2953,10 @@ void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2622,6 +2996,10 @@ void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2692,6 +3070,15 @@ void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesTextSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2762,6 +3149,11 @@ void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextSensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2799,6 +3191,10 @@ void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
 }
+void SubscribeLogsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_bool(total_size, 2, this->dump_config);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2842,6 +3238,11 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
 }
+void SubscribeLogsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_string(total_size, 3, this->message);
+  ProtoSize::add_bool(total_size, 4, this->send_failed);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2861,6 +3262,7 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeassistantServicesRequest {}");
@@ -2884,6 +3286,10 @@ void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
+void HomeassistantServiceMap::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceMap::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2915,15 +3321,18 @@ bool HomeassistantServiceResponse::decode_length(uint32_t field_id, ProtoLengthD
       return true;
     }
     case 2: {
-      this->data.push_back(value.as_message<HomeassistantServiceMap>());
+      this->data.emplace_back();
+      value.decode_to_message(this->data.back());
       return true;
     }
     case 3: {
-      this->data_template.push_back(value.as_message<HomeassistantServiceMap>());
+      this->data_template.emplace_back();
+      value.decode_to_message(this->data_template.back());
       return true;
     }
     case 4: {
-      this->variables.push_back(value.as_message<HomeassistantServiceMap>());
+      this->variables.emplace_back();
+      value.decode_to_message(this->variables.back());
       return true;
     }
     default:
@@ -2943,6 +3352,19 @@ void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_bool(5, this->is_event);
 }
+void HomeassistantServiceResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->service);
+  for (const auto &it : this->data) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 2, it, true);
+  }
+  for (const auto &it : this->data_template) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 3, it, true);
+  }
+  for (const auto &it : this->variables) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 4, it, true);
+  }
+  ProtoSize::add_bool(total_size, 5, this->is_event);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2976,6 +3398,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeAssistantStatesRequest {}");
@@ -2999,6 +3422,10 @@ void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->attribute);
 }
+void SubscribeHomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->entity_id);
+  ProtoSize::add_string(total_size, 2, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3016,15 +3443,15 @@ void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
 bool HomeAssistantStateResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->entity_id = value.as_string();
+      this->entity_id = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->attribute = value.as_string();
+      this->attribute = value.as_string_ref();
       return true;
     }
     default:
@@ -3036,25 +3463,31 @@ void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_string(3, this->attribute);
 }
+void HomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->entity_id);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_string(total_size, 3, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HomeAssistantStateResponse {\n");
   out.append("  entity_id: ");
-  out.append("'").append(this->entity_id).append("'");
+  out.append("'").append(this->entity_id.c_str(), this->entity_id.size()).append("'");
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
 
   out.append("  attribute: ");
-  out.append("'").append(this->attribute).append("'");
+  out.append("'").append(this->attribute.c_str(), this->attribute.size()).append("'");
   out.append("\n");
   out.append("}");
 }
 #endif
 void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
 #endif
@@ -3069,6 +3502,9 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3104,6 +3540,10 @@ void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
+void ListEntitiesServicesArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_enum<enums::ServiceArgType>(total_size, 2, this->type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3125,7 +3565,8 @@ bool ListEntitiesServicesResponse::decode_length(uint32_t field_id, ProtoLengthD
       return true;
     }
     case 3: {
-      this->args.push_back(value.as_message<ListEntitiesServicesArgument>());
+      this->args.emplace_back();
+      value.decode_to_message(this->args.back());
       return true;
     }
     default:
@@ -3149,6 +3590,13 @@ void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ListEntitiesServicesArgument>(3, it, true);
   }
 }
+void ListEntitiesServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  for (const auto &it : this->args) {
+    ProtoSize::add_message<ListEntitiesServicesArgument>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3199,11 +3647,11 @@ bool ExecuteServiceArgument::decode_varint(uint32_t field_id, ProtoVarInt value)
 bool ExecuteServiceArgument::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->string_ = value.as_string();
+      this->string_ = value.as_string_ref();
       return true;
     }
     case 9: {
-      this->string_array.push_back(value.as_string());
+      this->string_array.push_back(value.as_string_ref());
       return true;
     }
     default:
@@ -3243,6 +3691,25 @@ void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ExecuteServiceArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->bool_);
+  ProtoSize::add_int32(total_size, 2, this->legacy_int);
+  ProtoSize::add_float(total_size, 3, this->float_);
+  ProtoSize::add_string(total_size, 4, this->string_);
+  ProtoSize::add_sint32(total_size, 5, this->int_);
+  for (const auto it : this->bool_array) {
+    ProtoSize::add_bool(total_size, 6, it, true);
+  }
+  for (const auto &it : this->int_array) {
+    ProtoSize::add_sint32(total_size, 7, it, true);
+  }
+  for (const auto &it : this->float_array) {
+    ProtoSize::add_float(total_size, 8, it, true);
+  }
+  for (const auto &it : this->string_array) {
+    ProtoSize::add_string(total_size, 9, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3262,7 +3729,7 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  string_: ");
-  out.append("'").append(this->string_).append("'");
+  out.append("'").append(this->string_.c_str(), this->string_.size()).append("'");
   out.append("\n");
 
   out.append("  int_: ");
@@ -3292,7 +3759,7 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
 
   for (const auto &it : this->string_array) {
     out.append("  string_array: ");
-    out.append("'").append(it).append("'");
+    out.append("'").append(it.c_str(), it.size()).append("'");
     out.append("\n");
   }
   out.append("}");
@@ -3301,7 +3768,8 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
 bool ExecuteServiceRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->args.push_back(value.as_message<ExecuteServiceArgument>());
+      this->args.emplace_back();
+      value.decode_to_message(this->args.back());
       return true;
     }
     default:
@@ -3324,6 +3792,12 @@ void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
   }
 }
+void ExecuteServiceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  for (const auto &it : this->args) {
+    ProtoSize::add_message<ExecuteServiceArgument>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3396,6 +3870,15 @@ void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(6, this->icon);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesCameraResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 6, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCameraResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3466,6 +3949,11 @@ void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
 }
+void CameraImageResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->data);
+  ProtoSize::add_bool(total_size, 3, this->done);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3503,6 +3991,10 @@ void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
+void CameraImageRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->single);
+  ProtoSize::add_bool(total_size, 2, this->stream);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3654,6 +4146,41 @@ void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(20, this->entity_category);
   buffer.encode_float(21, this->visual_current_temperature_step);
 }
+void ListEntitiesClimateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->supports_current_temperature);
+  ProtoSize::add_bool(total_size, 6, this->supports_two_point_target_temperature);
+  for (const auto &it : this->supported_modes) {
+    ProtoSize::add_enum<enums::ClimateMode>(total_size, 7, it, true);
+  }
+  ProtoSize::add_float(total_size, 8, this->visual_min_temperature);
+  ProtoSize::add_float(total_size, 9, this->visual_max_temperature);
+  ProtoSize::add_float(total_size, 10, this->visual_target_temperature_step);
+  ProtoSize::add_bool(total_size, 11, this->legacy_supports_away);
+  ProtoSize::add_bool(total_size, 12, this->supports_action);
+  for (const auto &it : this->supported_fan_modes) {
+    ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 13, it, true);
+  }
+  for (const auto &it : this->supported_swing_modes) {
+    ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 14, it, true);
+  }
+  for (const auto &it : this->supported_custom_fan_modes) {
+    ProtoSize::add_string(total_size, 15, it, true);
+  }
+  for (const auto &it : this->supported_presets) {
+    ProtoSize::add_enum<enums::ClimatePreset>(total_size, 16, it, true);
+  }
+  for (const auto &it : this->supported_custom_presets) {
+    ProtoSize::add_string(total_size, 17, it, true);
+  }
+  ProtoSize::add_bool(total_size, 18, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 19, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 20, this->entity_category);
+  ProtoSize::add_float(total_size, 21, this->visual_current_temperature_step);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesClimateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3846,6 +4373,21 @@ void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::ClimatePreset>(12, this->preset);
   buffer.encode_string(13, this->custom_preset);
 }
+void ClimateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::ClimateMode>(total_size, 2, this->mode);
+  ProtoSize::add_float(total_size, 3, this->current_temperature);
+  ProtoSize::add_float(total_size, 4, this->target_temperature);
+  ProtoSize::add_float(total_size, 5, this->target_temperature_low);
+  ProtoSize::add_float(total_size, 6, this->target_temperature_high);
+  ProtoSize::add_bool(total_size, 7, this->unused_legacy_away);
+  ProtoSize::add_enum<enums::ClimateAction>(total_size, 8, this->action);
+  ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 9, this->fan_mode);
+  ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 10, this->swing_mode);
+  ProtoSize::add_string(total_size, 11, this->custom_fan_mode);
+  ProtoSize::add_enum<enums::ClimatePreset>(total_size, 12, this->preset);
+  ProtoSize::add_string(total_size, 13, this->custom_preset);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4034,6 +4576,29 @@ void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(20, this->has_custom_preset);
   buffer.encode_string(21, this->custom_preset);
 }
+void ClimateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_mode);
+  ProtoSize::add_enum<enums::ClimateMode>(total_size, 3, this->mode);
+  ProtoSize::add_bool(total_size, 4, this->has_target_temperature);
+  ProtoSize::add_float(total_size, 5, this->target_temperature);
+  ProtoSize::add_bool(total_size, 6, this->has_target_temperature_low);
+  ProtoSize::add_float(total_size, 7, this->target_temperature_low);
+  ProtoSize::add_bool(total_size, 8, this->has_target_temperature_high);
+  ProtoSize::add_float(total_size, 9, this->target_temperature_high);
+  ProtoSize::add_bool(total_size, 10, this->unused_has_legacy_away);
+  ProtoSize::add_bool(total_size, 11, this->unused_legacy_away);
+  ProtoSize::add_bool(total_size, 12, this->has_fan_mode);
+  ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 13, this->fan_mode);
+  ProtoSize::add_bool(total_size, 14, this->has_swing_mode);
+  ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 15, this->swing_mode);
+  ProtoSize::add_bool(total_size, 16, this->has_custom_fan_mode);
+  ProtoSize::add_string(total_size, 17, this->custom_fan_mode);
+  ProtoSize::add_bool(total_size, 18, this->has_preset);
+  ProtoSize::add_enum<enums::ClimatePreset>(total_size, 19, this->preset);
+  ProtoSize::add_bool(total_size, 20, this->has_custom_preset);
+  ProtoSize::add_string(total_size, 21, this->custom_preset);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4213,6 +4778,21 @@ void ListEntitiesNumberResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::NumberMode>(12, this->mode);
   buffer.encode_string(13, this->device_class);
 }
+void ListEntitiesNumberResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_float(total_size, 6, this->min_value);
+  ProtoSize::add_float(total_size, 7, this->max_value);
+  ProtoSize::add_float(total_size, 8, this->step);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 10, this->entity_category);
+  ProtoSize::add_string(total_size, 11, this->unit_of_measurement);
+  ProtoSize::add_enum<enums::NumberMode>(total_size, 12, this->mode);
+  ProtoSize::add_string(total_size, 13, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesNumberResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4304,6 +4884,11 @@ void NumberStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void NumberStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4342,6 +4927,10 @@ void NumberCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
 }
+void NumberCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4420,6 +5009,18 @@ void ListEntitiesSelectResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(7, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
 }
+void ListEntitiesSelectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  for (const auto &it : this->options) {
+    ProtoSize::add_string(total_size, 6, it, true);
+  }
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 8, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSelectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4496,6 +5097,11 @@ void SelectStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SelectStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4539,6 +5145,10 @@ void SelectCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void SelectCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4629,6 +5239,19 @@ void ListEntitiesLockResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->requires_code);
   buffer.encode_string(11, this->code_format);
 }
+void ListEntitiesLockResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool(total_size, 8, this->assumed_state);
+  ProtoSize::add_bool(total_size, 9, this->supports_open);
+  ProtoSize::add_bool(total_size, 10, this->requires_code);
+  ProtoSize::add_string(total_size, 11, this->code_format);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLockResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4704,6 +5327,10 @@ void LockStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockState>(2, this->state);
 }
+void LockStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LockState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4759,6 +5386,12 @@ void LockCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_code);
   buffer.encode_string(4, this->code);
 }
+void LockCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LockCommand>(total_size, 2, this->command);
+  ProtoSize::add_bool(total_size, 3, this->has_code);
+  ProtoSize::add_string(total_size, 4, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4842,6 +5475,16 @@ void ListEntitiesButtonResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesButtonResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesButtonResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4892,6 +5535,9 @@ bool ButtonCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void ButtonCommandRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->key); }
+void ButtonCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ButtonCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4963,6 +5609,16 @@ void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_bool(8, this->supports_pause);
 }
+void ListEntitiesMediaPlayerResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool(total_size, 8, this->supports_pause);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesMediaPlayerResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5036,6 +5692,12 @@ void MediaPlayerStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(3, this->volume);
   buffer.encode_bool(4, this->muted);
 }
+void MediaPlayerStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::MediaPlayerState>(total_size, 2, this->state);
+  ProtoSize::add_float(total_size, 3, this->volume);
+  ProtoSize::add_bool(total_size, 4, this->muted);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5115,6 +5777,15 @@ void MediaPlayerCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->has_media_url);
   buffer.encode_string(7, this->media_url);
 }
+void MediaPlayerCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_command);
+  ProtoSize::add_enum<enums::MediaPlayerCommand>(total_size, 3, this->command);
+  ProtoSize::add_bool(total_size, 4, this->has_volume);
+  ProtoSize::add_float(total_size, 5, this->volume);
+  ProtoSize::add_bool(total_size, 6, this->has_media_url);
+  ProtoSize::add_string(total_size, 7, this->media_url);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5164,6 +5835,9 @@ bool SubscribeBluetoothLEAdvertisementsRequest::decode_varint(uint32_t field_id,
 void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->flags);
 }
+void SubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5206,6 +5880,13 @@ void BluetoothServiceData::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_string(3, this->data);
 }
+void BluetoothServiceData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->uuid);
+  for (const auto &it : this->legacy_data) {
+    ProtoSize::add_uint32(total_size, 2, it, true);
+  }
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothServiceData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5256,11 +5937,13 @@ bool BluetoothLEAdvertisementResponse::decode_length(uint32_t field_id, ProtoLen
       return true;
     }
     case 5: {
-      this->service_data.push_back(value.as_message<BluetoothServiceData>());
+      this->service_data.emplace_back();
+      value.decode_to_message(this->service_data.back());
       return true;
     }
     case 6: {
-      this->manufacturer_data.push_back(value.as_message<BluetoothServiceData>());
+      this->manufacturer_data.emplace_back();
+      value.decode_to_message(this->manufacturer_data.back());
       return true;
     }
     default:
@@ -5282,6 +5965,21 @@ void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(7, this->address_type);
 }
+void BluetoothLEAdvertisementResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_string(total_size, 2, this->name);
+  ProtoSize::add_sint32(total_size, 3, this->rssi);
+  for (const auto &it : this->service_uuids) {
+    ProtoSize::add_string(total_size, 4, it, true);
+  }
+  for (const auto &it : this->service_data) {
+    ProtoSize::add_message<BluetoothServiceData>(total_size, 5, it, true);
+  }
+  for (const auto &it : this->manufacturer_data) {
+    ProtoSize::add_message<BluetoothServiceData>(total_size, 6, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 7, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLEAdvertisementResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5359,6 +6057,12 @@ void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->address_type);
   buffer.encode_string(4, this->data);
 }
+void BluetoothLERawAdvertisement::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_sint32(total_size, 2, this->rssi);
+  ProtoSize::add_uint32(total_size, 3, this->address_type);
+  ProtoSize::add_string(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5387,7 +6091,8 @@ void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
 bool BluetoothLERawAdvertisementsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->advertisements.push_back(value.as_message<BluetoothLERawAdvertisement>());
+      this->advertisements.emplace_back();
+      value.decode_to_message(this->advertisements.back());
       return true;
     }
     default:
@@ -5399,6 +6104,11 @@ void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const
     buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
   }
 }
+void BluetoothLERawAdvertisementsResponse::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->advertisements) {
+    ProtoSize::add_message<BluetoothLERawAdvertisement>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisementsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5439,6 +6149,12 @@ void BluetoothDeviceRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_address_type);
   buffer.encode_uint32(4, this->address_type);
 }
+void BluetoothDeviceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_enum<enums::BluetoothDeviceRequestType>(total_size, 2, this->request_type);
+  ProtoSize::add_bool(total_size, 3, this->has_address_type);
+  ProtoSize::add_uint32(total_size, 4, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5491,6 +6207,12 @@ void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->mtu);
   buffer.encode_int32(4, this->error);
 }
+void BluetoothDeviceConnectionResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->connected);
+  ProtoSize::add_uint32(total_size, 3, this->mtu);
+  ProtoSize::add_int32(total_size, 4, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceConnectionResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5527,6 +6249,9 @@ bool BluetoothGATTGetServicesRequest::decode_varint(uint32_t field_id, ProtoVarI
   }
 }
 void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint64(1, this->address); }
+void BluetoothGATTGetServicesRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5558,6 +6283,12 @@ void BluetoothGATTDescriptor::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTDescriptor::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTDescriptor::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5597,7 +6328,8 @@ bool BluetoothGATTCharacteristic::decode_varint(uint32_t field_id, ProtoVarInt v
 bool BluetoothGATTCharacteristic::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->descriptors.push_back(value.as_message<BluetoothGATTDescriptor>());
+      this->descriptors.emplace_back();
+      value.decode_to_message(this->descriptors.back());
       return true;
     }
     default:
@@ -5614,6 +6346,16 @@ void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTDescriptor>(4, it, true);
   }
 }
+void BluetoothGATTCharacteristic::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_uint32(total_size, 3, this->properties);
+  for (const auto &it : this->descriptors) {
+    ProtoSize::add_message<BluetoothGATTDescriptor>(total_size, 4, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTCharacteristic::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5660,7 +6402,8 @@ bool BluetoothGATTService::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool BluetoothGATTService::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->characteristics.push_back(value.as_message<BluetoothGATTCharacteristic>());
+      this->characteristics.emplace_back();
+      value.decode_to_message(this->characteristics.back());
       return true;
     }
     default:
@@ -5676,6 +6419,15 @@ void BluetoothGATTService::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTCharacteristic>(3, it, true);
   }
 }
+void BluetoothGATTService::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  for (const auto &it : this->characteristics) {
+    ProtoSize::add_message<BluetoothGATTCharacteristic>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTService::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5713,7 +6465,8 @@ bool BluetoothGATTGetServicesResponse::decode_varint(uint32_t field_id, ProtoVar
 bool BluetoothGATTGetServicesResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->services.push_back(value.as_message<BluetoothGATTService>());
+      this->services.emplace_back();
+      value.decode_to_message(this->services.back());
       return true;
     }
     default:
@@ -5726,6 +6479,12 @@ void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTService>(2, it, true);
   }
 }
+void BluetoothGATTGetServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  for (const auto &it : this->services) {
+    ProtoSize::add_message<BluetoothGATTService>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5756,6 +6515,9 @@ bool BluetoothGATTGetServicesDoneResponse::decode_varint(uint32_t field_id, Prot
 void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
 }
+void BluetoothGATTGetServicesDoneResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesDoneResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5785,6 +6547,10 @@ void BluetoothGATTReadRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5830,6 +6596,11 @@ void BluetoothGATTReadResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTReadResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5871,7 +6642,7 @@ bool BluetoothGATTWriteRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool BluetoothGATTWriteRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -5884,6 +6655,12 @@ void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->response);
   buffer.encode_string(4, this->data);
 }
+void BluetoothGATTWriteRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_bool(total_size, 3, this->response);
+  ProtoSize::add_string(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5903,7 +6680,7 @@ void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5926,6 +6703,10 @@ void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5959,7 +6740,7 @@ bool BluetoothGATTWriteDescriptorRequest::decode_varint(uint32_t field_id, Proto
 bool BluetoothGATTWriteDescriptorRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -5971,6 +6752,11 @@ void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer buffer) const
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTWriteDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5986,7 +6772,7 @@ void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -6014,6 +6800,11 @@ void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->enable);
 }
+void BluetoothGATTNotifyRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_bool(total_size, 3, this->enable);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6063,6 +6854,11 @@ void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTNotifyDataResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6084,6 +6880,7 @@ void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeBluetoothConnectionsFreeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothConnectionsFreeRequest::dump_to(std::string &out) const {
   out.append("SubscribeBluetoothConnectionsFreeRequest {}");
@@ -6107,6 +6904,10 @@ void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->free);
   buffer.encode_uint32(2, this->limit);
 }
+void BluetoothConnectionsFreeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->free);
+  ProtoSize::add_uint32(total_size, 2, this->limit);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothConnectionsFreeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6146,6 +6947,11 @@ void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothGATTErrorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTErrorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6185,6 +6991,10 @@ void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTWriteResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6219,6 +7029,10 @@ void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTNotifyResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6258,6 +7072,11 @@ void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->paired);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDevicePairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->paired);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDevicePairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6301,6 +7120,11 @@ void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceUnpairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->success);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6322,6 +7146,7 @@ void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
 }
 #endif
 void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+void UnsubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UnsubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   out.append("UnsubscribeBluetoothLEAdvertisementsRequest {}");
@@ -6350,6 +7175,11 @@ void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceClearCacheResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->success);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceClearCacheResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6381,6 +7211,9 @@ bool SubscribeVoiceAssistantRequest::decode_varint(uint32_t field_id, ProtoVarIn
   }
 }
 void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->subscribe); }
+void SubscribeVoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->subscribe);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeVoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6420,6 +7253,11 @@ void VoiceAssistantAudioSettings::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->auto_gain);
   buffer.encode_float(3, this->volume_multiplier);
 }
+void VoiceAssistantAudioSettings::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->noise_suppression_level);
+  ProtoSize::add_uint32(total_size, 2, this->auto_gain);
+  ProtoSize::add_float(total_size, 3, this->volume_multiplier);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAudioSettings::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6462,7 +7300,7 @@ bool VoiceAssistantRequest::decode_length(uint32_t field_id, ProtoLengthDelimite
       return true;
     }
     case 4: {
-      this->audio_settings = value.as_message<VoiceAssistantAudioSettings>();
+      value.decode_to_message(this->audio_settings);
       return true;
     }
     default:
@@ -6475,6 +7313,12 @@ void VoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->flags);
   buffer.encode_message<VoiceAssistantAudioSettings>(4, this->audio_settings);
 }
+void VoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->start);
+  ProtoSize::add_string(total_size, 2, this->conversation_id);
+  ProtoSize::add_uint32(total_size, 3, this->flags);
+  ProtoSize::add_message<VoiceAssistantAudioSettings>(total_size, 4, this->audio_settings);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6516,6 +7360,10 @@ void VoiceAssistantResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->port);
   buffer.encode_bool(2, this->error);
 }
+void VoiceAssistantResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->port);
+  ProtoSize::add_bool(total_size, 2, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6549,6 +7397,10 @@ void VoiceAssistantEventData::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_string(2, this->value);
 }
+void VoiceAssistantEventData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_string(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6576,7 +7428,8 @@ bool VoiceAssistantEventResponse::decode_varint(uint32_t field_id, ProtoVarInt v
 bool VoiceAssistantEventResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->data.push_back(value.as_message<VoiceAssistantEventData>());
+      this->data.emplace_back();
+      value.decode_to_message(this->data.back());
       return true;
     }
     default:
@@ -6589,6 +7442,12 @@ void VoiceAssistantEventResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<VoiceAssistantEventData>(2, it, true);
   }
 }
+void VoiceAssistantEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::VoiceAssistantEvent>(total_size, 1, this->event_type);
+  for (const auto &it : this->data) {
+    ProtoSize::add_message<VoiceAssistantEventData>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6675,6 +7534,18 @@ void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer buffer) cons
   buffer.encode_bool(9, this->requires_code);
   buffer.encode_bool(10, this->requires_code_to_arm);
 }
+void ListEntitiesAlarmControlPanelResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32(total_size, 8, this->supported_features);
+  ProtoSize::add_bool(total_size, 9, this->requires_code);
+  ProtoSize::add_bool(total_size, 10, this->requires_code_to_arm);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesAlarmControlPanelResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6747,6 +7618,10 @@ void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelState>(2, this->state);
 }
+void AlarmControlPanelStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::AlarmControlPanelState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6797,6 +7672,11 @@ void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::AlarmControlPanelStateCommand>(2, this->command);
   buffer.encode_string(3, this->code);
 }
+void AlarmControlPanelCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::AlarmControlPanelStateCommand>(total_size, 2, this->command);
+  ProtoSize::add_string(total_size, 3, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6891,6 +7771,19 @@ void ListEntitiesTextResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(10, this->pattern);
   buffer.encode_enum<enums::TextMode>(11, this->mode);
 }
+void ListEntitiesTextResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32(total_size, 8, this->min_length);
+  ProtoSize::add_uint32(total_size, 9, this->max_length);
+  ProtoSize::add_string(total_size, 10, this->pattern);
+  ProtoSize::add_enum<enums::TextMode>(total_size, 11, this->mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6979,6 +7872,11 @@ void TextStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7022,6 +7920,10 @@ void TextCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void TextCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7037,6 +7939,446 @@ void TextCommandRequest::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+bool ProfilerStatsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->reset = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ProfilerStatsRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->reset); }
+void ProfilerStatsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->reset);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ProfilerStatsRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ProfilerStatsRequest {\n");
+  out.append("  reset: ");
+  out.append(YESNO(this->reset));
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ProfilerStatsResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->section = value.as_enum<enums::ProfilerSection>();
+      return true;
+    }
+    case 4: {
+      this->count = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->total_us = value.as_uint64();
+      return true;
+    }
+    case 6: {
+      this->max_us = value.as_uint32();
+      return true;
+    }
+    case 7: {
+      this->p99_us = value.as_uint32();
+      return true;
+    }
+    case 8: {
+      this->instance = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ProfilerStatsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->component = value.as_string();
+      return true;
+    }
+    case 3: {
+      this->name = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ProfilerStatsResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->component);
+  buffer.encode_enum<enums::ProfilerSection>(2, this->section);
+  buffer.encode_string(3, this->name);
+  buffer.encode_uint32(4, this->count);
+  buffer.encode_uint64(5, this->total_us);
+  buffer.encode_uint32(6, this->max_us);
+  buffer.encode_uint32(7, this->p99_us);
+  buffer.encode_uint32(8, this->instance);
+}
+void ProfilerStatsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->component);
+  ProtoSize::add_enum<enums::ProfilerSection>(total_size, 2, this->section);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_uint32(total_size, 4, this->count);
+  ProtoSize::add_uint64(total_size, 5, this->total_us);
+  ProtoSize::add_uint32(total_size, 6, this->max_us);
+  ProtoSize::add_uint32(total_size, 7, this->p99_us);
+  ProtoSize::add_uint32(total_size, 8, this->instance);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ProfilerStatsResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ProfilerStatsResponse {\n");
+  out.append("  component: ");
+  out.append("'").append(this->component).append("'");
+  out.append("\n");
+
+  out.append("  section: ");
+  out.append(proto_enum_to_string<enums::ProfilerSection>(this->section));
+  out.append("\n");
+
+  out.append("  name: ");
+  out.append("'").append(this->name).append("'");
+  out.append("\n");
+
+  out.append("  count: ");
+  sprintf(buffer, "%" PRIu32, this->count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  total_us: ");
+  sprintf(buffer, "%llu", this->total_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  max_us: ");
+  sprintf(buffer, "%" PRIu32, this->max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  p99_us: ");
+  sprintf(buffer, "%" PRIu32, this->p99_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  instance: ");
+  sprintf(buffer, "%" PRIu32, this->instance);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ProfilerStatsDoneResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->duration_ms = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ProfilerStatsDoneResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint32(1, this->duration_ms); }
+void ProfilerStatsDoneResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->duration_ms);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ProfilerStatsDoneResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ProfilerStatsDoneResponse {\n");
+  out.append("  duration_ms: ");
+  sprintf(buffer, "%" PRIu32, this->duration_ms);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool LogHistoryRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->current_boot = value.as_bool();
+      return true;
+    }
+    case 2: {
+      this->clear = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void LogHistoryRequest::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_bool(1, this->current_boot);
+  buffer.encode_bool(2, this->clear);
+}
+void LogHistoryRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->current_boot);
+  ProtoSize::add_bool(total_size, 1, this->clear);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void LogHistoryRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("LogHistoryRequest {\n");
+  out.append("  current_boot: ");
+  out.append(YESNO(this->current_boot));
+  out.append("\n");
+
+  out.append("  clear: ");
+  out.append(YESNO(this->clear));
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool LogHistoryResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 3: {
+      this->done = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool LogHistoryResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->data = value.as_string();
+      return true;
+    }
+    case 2: {
+      this->reset_reason = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void LogHistoryResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->data);
+  buffer.encode_string(2, this->reset_reason);
+  buffer.encode_bool(3, this->done);
+}
+void LogHistoryResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->data);
+  ProtoSize::add_string(total_size, 2, this->reset_reason);
+  ProtoSize::add_bool(total_size, 3, this->done);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void LogHistoryResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("LogHistoryResponse {\n");
+  out.append("  data: ");
+  out.append("'").append(this->data).append("'");
+  out.append("\n");
+
+  out.append("  reset_reason: ");
+  out.append("'").append(this->reset_reason).append("'");
+  out.append("\n");
+
+  out.append("  done: ");
+  out.append(YESNO(this->done));
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SensorHistoryRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->resolution = value.as_enum<enums::SensorHistoryResolution>();
+      return true;
+    }
+    case 3: {
+      this->max_age_ms = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SensorHistoryRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SensorHistoryRequest::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  buffer.encode_enum<enums::SensorHistoryResolution>(2, this->resolution);
+  buffer.encode_uint32(3, this->max_age_ms);
+}
+void SensorHistoryRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::SensorHistoryResolution>(total_size, 2, this->resolution);
+  ProtoSize::add_uint32(total_size, 3, this->max_age_ms);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SensorHistoryRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SensorHistoryRequest {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%" PRIu32, this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  resolution: ");
+  out.append(proto_enum_to_string<enums::SensorHistoryResolution>(this->resolution));
+  out.append("\n");
+
+  out.append("  max_age_ms: ");
+  sprintf(buffer, "%" PRIu32, this->max_age_ms);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SensorHistoryPoint::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->age_ms = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SensorHistoryPoint::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 2: {
+      this->mean = value.as_float();
+      return true;
+    }
+    case 3: {
+      this->min = value.as_float();
+      return true;
+    }
+    case 4: {
+      this->max = value.as_float();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SensorHistoryPoint::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint32(1, this->age_ms);
+  buffer.encode_float(2, this->mean);
+  buffer.encode_float(3, this->min);
+  buffer.encode_float(4, this->max);
+}
+void SensorHistoryPoint::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->age_ms);
+  ProtoSize::add_float(total_size, 2, this->mean);
+  ProtoSize::add_float(total_size, 3, this->min);
+  ProtoSize::add_float(total_size, 4, this->max);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SensorHistoryPoint::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SensorHistoryPoint {\n");
+  out.append("  age_ms: ");
+  sprintf(buffer, "%" PRIu32, this->age_ms);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  mean: ");
+  sprintf(buffer, "%g", this->mean);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  min: ");
+  sprintf(buffer, "%g", this->min);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  max: ");
+  sprintf(buffer, "%g", this->max);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SensorHistoryResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->resolution = value.as_enum<enums::SensorHistoryResolution>();
+      return true;
+    }
+    case 4: {
+      this->done = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SensorHistoryResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 3: {
+      this->points.emplace_back();
+      value.decode_to_message(this->points.back());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SensorHistoryResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SensorHistoryResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  buffer.encode_enum<enums::SensorHistoryResolution>(2, this->resolution);
+  for (auto &it : this->points) {
+    buffer.encode_message<SensorHistoryPoint>(3, it, true);
+  }
+  buffer.encode_bool(4, this->done);
+}
+void SensorHistoryResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::SensorHistoryResolution>(total_size, 2, this->resolution);
+  for (const auto &it : this->points) {
+    ProtoSize::add_message<SensorHistoryPoint>(total_size, 3, it, true);
+  }
+  ProtoSize::add_bool(total_size, 4, this->done);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SensorHistoryResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SensorHistoryResponse {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%" PRIu32, this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  resolution: ");
+  out.append(proto_enum_to_string<enums::SensorHistoryResolution>(this->resolution));
+  out.append("\n");
+
+  for (const auto &it : this->points) {
+    out.append("  points: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+
+  out.append("  done: ");
+  out.append(YESNO(this->done));
+  out.append("\n");
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
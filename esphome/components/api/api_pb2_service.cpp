@@ -513,6 +513,44 @@ bool APIServerConnectionBase::send_text_state_response(const TextStateResponse &
 #endif
 #ifdef USE_TEXT
 #endif
+#ifdef USE_PROFILER
+#endif
+#ifdef USE_PROFILER
+bool APIServerConnectionBase::send_profiler_stats_response(const ProfilerStatsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_profiler_stats_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ProfilerStatsResponse>(msg, 101);
+}
+#endif
+#ifdef USE_PROFILER
+bool APIServerConnectionBase::send_profiler_stats_done_response(const ProfilerStatsDoneResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_profiler_stats_done_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ProfilerStatsDoneResponse>(msg, 102);
+}
+#endif
+#ifdef USE_LOGGER_HISTORY
+#endif
+#ifdef USE_LOGGER_HISTORY
+bool APIServerConnectionBase::send_log_history_response(const LogHistoryResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_log_history_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<LogHistoryResponse>(msg, 104);
+}
+#endif
+#ifdef USE_SENSOR_HISTORY
+#endif
+#ifdef USE_SENSOR_HISTORY
+bool APIServerConnectionBase::send_sensor_history_response(const SensorHistoryResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_sensor_history_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<SensorHistoryResponse>(msg, 106);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -942,6 +980,39 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_text_command_request: %s", msg.dump().c_str());
 #endif
       this->on_text_command_request(msg);
+#endif
+      break;
+    }
+    case 100: {
+#ifdef USE_PROFILER
+      ProfilerStatsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_profiler_stats_request: %s", msg.dump().c_str());
+#endif
+      this->on_profiler_stats_request(msg);
+#endif
+      break;
+    }
+    case 103: {
+#ifdef USE_LOGGER_HISTORY
+      LogHistoryRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_log_history_request: %s", msg.dump().c_str());
+#endif
+      this->on_log_history_request(msg);
+#endif
+      break;
+    }
+    case 105: {
+#ifdef USE_SENSOR_HISTORY
+      SensorHistoryRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_sensor_history_request: %s", msg.dump().c_str());
+#endif
+      this->on_sensor_history_request(msg);
 #endif
       break;
     }
@@ -1380,6 +1451,45 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_PROFILER
+void APIServerConnection::on_profiler_stats_request(const ProfilerStatsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->profiler_stats(msg);
+}
+#endif
+#ifdef USE_LOGGER_HISTORY
+void APIServerConnection::on_log_history_request(const LogHistoryRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->log_history(msg);
+}
+#endif
+#ifdef USE_SENSOR_HISTORY
+void APIServerConnection::on_sensor_history_request(const SensorHistoryRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->sensor_history(msg);
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -257,6 +257,27 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_TEXT
   virtual void on_text_command_request(const TextCommandRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  virtual void on_profiler_stats_request(const ProfilerStatsRequest &value){};
+#endif
+#ifdef USE_PROFILER
+  bool send_profiler_stats_response(const ProfilerStatsResponse &msg);
+#endif
+#ifdef USE_PROFILER
+  bool send_profiler_stats_done_response(const ProfilerStatsDoneResponse &msg);
+#endif
+#ifdef USE_LOGGER_HISTORY
+  virtual void on_log_history_request(const LogHistoryRequest &value){};
+#endif
+#ifdef USE_LOGGER_HISTORY
+  bool send_log_history_response(const LogHistoryResponse &msg);
+#endif
+#ifdef USE_SENSOR_HISTORY
+  virtual void on_sensor_history_request(const SensorHistoryRequest &value){};
+#endif
+#ifdef USE_SENSOR_HISTORY
+  bool send_sensor_history_response(const SensorHistoryResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -348,6 +369,15 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_PROFILER
+  virtual void profiler_stats(const ProfilerStatsRequest &msg) = 0;
+#endif
+#ifdef USE_LOGGER_HISTORY
+  virtual void log_history(const LogHistoryRequest &msg) = 0;
+#endif
+#ifdef USE_SENSOR_HISTORY
+  virtual void sensor_history(const SensorHistoryRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -435,6 +465,15 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_PROFILER
+  void on_profiler_stats_request(const ProfilerStatsRequest &msg) override;
+#endif
+#ifdef USE_LOGGER_HISTORY
+  void on_log_history_request(const LogHistoryRequest &msg) override;
+#endif
+#ifdef USE_SENSOR_HISTORY
+  void on_sensor_history_request(const SensorHistoryRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -65,16 +65,9 @@ void APIServer::setup() {
     this->mark_failed();
     return;
   }
-
-#ifdef USE_LOGGER
-  if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      for (auto &c : this->clients_) {
-        if (!c->remove_)
-          c->send_log_message(level, tag, message);
-      }
-    });
-  }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // wake the main loop as soon as a client connects
+  App.register_socket_fd(this->socket_->get_fd());
 #endif
 
   this->last_connected_ = millis();
@@ -91,6 +84,20 @@ void APIServer::setup() {
   }
 #endif
 }
+void APIServer::forward_logs() {
+#ifdef USE_LOGGER
+  // registered on the first subscription, so the logger doesn't format messages for the API before anyone listens
+  if (this->forwarding_logs_ || logger::global_logger == nullptr)
+    return;
+  this->forwarding_logs_ = true;
+  logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+    for (auto &c : this->clients_) {
+      if (!c->remove_)
+        c->send_log_message(level, tag, message);
+    }
+  });
+#endif
+}
 void APIServer::loop() {
   // Accept new clients
   while (true) {
@@ -174,120 +181,131 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
+bool APIServer::has_state_subscription_() const {
+  for (auto &c : this->clients_) {
+    if (c->state_subscription_)
+      return true;
+  }
+  return false;
+}
+template<class C> void APIServer::send_state_(enums::StateEntityType entity_type, const C &msg, optional<float> value) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_state: %s", msg.dump().c_str());
+#endif
+  // Encode once and hand the same payload to every subscribed connection, the frame helpers only read from it
+  uint32_t msg_size = 0;
+  msg.calculate_size(msg_size);
+  this->state_buffer_.clear();
+  this->state_buffer_.reserve(msg_size);
+  ProtoWriteBuffer buffer{&this->state_buffer_};
+  msg.encode(buffer);
+  for (auto &c : this->clients_) {
+    if (c->state_subscription_)
+      c->send_shared_state(entity_type, msg.key, value, this->state_buffer_, C::MESSAGE_TYPE);
+  }
+}
 #ifdef USE_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_binary_sensor_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_BINARY_SENSOR,
+                    APIConnection::make_binary_sensor_state_response(obj, state));
 }
 #endif
 
 #ifdef USE_COVER
 void APIServer::on_cover_update(cover::Cover *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_cover_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_COVER, APIConnection::make_cover_state_response(obj));
 }
 #endif
 
 #ifdef USE_FAN
 void APIServer::on_fan_update(fan::Fan *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_fan_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_FAN, APIConnection::make_fan_state_response(obj));
 }
 #endif
 
 #ifdef USE_LIGHT
 void APIServer::on_light_update(light::LightState *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_light_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_LIGHT, APIConnection::make_light_state_response(obj));
 }
 #endif
 
 #ifdef USE_SENSOR
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_sensor_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_SENSOR, APIConnection::make_sensor_state_response(obj, state), state);
 }
 #endif
 
 #ifdef USE_SWITCH
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_switch_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_SWITCH, APIConnection::make_switch_state_response(obj, state));
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
 void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_text_sensor_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_TEXT_SENSOR, APIConnection::make_text_sensor_state_response(obj, state));
 }
 #endif
 
 #ifdef USE_CLIMATE
 void APIServer::on_climate_update(climate::Climate *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_climate_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_CLIMATE, APIConnection::make_climate_state_response(obj));
 }
 #endif
 
 #ifdef USE_NUMBER
 void APIServer::on_number_update(number::Number *obj, float state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_number_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_NUMBER, APIConnection::make_number_state_response(obj, state), state);
 }
 #endif
 
 #ifdef USE_TEXT
 void APIServer::on_text_update(text::Text *obj, const std::string &state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_text_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_TEXT, APIConnection::make_text_state_response(obj, state));
 }
 #endif
 
 #ifdef USE_SELECT
 void APIServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_select_state(obj, state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_SELECT, APIConnection::make_select_state_response(obj, state));
 }
 #endif
 
 #ifdef USE_LOCK
 void APIServer::on_lock_update(lock::Lock *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_lock_state(obj, obj->state);
+  this->send_state_(enums::STATE_ENTITY_TYPE_LOCK, APIConnection::make_lock_state_response(obj, obj->state));
 }
 #endif
 
 #ifdef USE_MEDIA_PLAYER
 void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_media_player_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_MEDIA_PLAYER, APIConnection::make_media_player_state_response(obj));
 }
 #endif
 
@@ -328,16 +346,17 @@ bool APIServer::is_connected() const { return !this->clients_.empty(); }
 void APIServer::on_shutdown() {
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
+    c->flush_batch_();
   }
   delay(10);
 }
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscription_())
     return;
-  for (auto &c : this->clients_)
-    c->send_alarm_control_panel_state(obj);
+  this->send_state_(enums::STATE_ENTITY_TYPE_ALARM_CONTROL_PANEL,
+                    APIConnection::make_alarm_control_panel_state_response(obj));
 }
 #endif
 
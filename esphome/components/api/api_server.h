@@ -32,6 +32,10 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
+  /// Start forwarding log messages to the connections that subscribed to logs.
+  void forward_logs();
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -107,11 +111,21 @@ class APIServer : public Component, public Controller {
   }
 
  protected:
+  bool has_state_subscription_() const;
+  /// Encode a state message once and send it to every connection that subscribed to states.
+  /// `value` is the numeric state that the deadband of state filters applies to.
+  template<class C> void send_state_(enums::StateEntityType entity_type, const C &msg, optional<float> value = {});
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  /// Maximum time messages are held back to be written to the socket together.
+  uint32_t batch_delay_{0};
+  bool forwarding_logs_{false};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
+  /// Encoded state message shared by all connections, re-used to prevent allocations.
+  std::vector<uint8_t> state_buffer_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
   std::vector<UserServiceDescriptor *> user_services_;
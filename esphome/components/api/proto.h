@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
 #include <vector>
 
@@ -71,21 +72,26 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
     }
   }
-  void encode(std::vector<uint8_t> &out) {
+  /// Number of bytes encode() produces for this value.
+  uint8_t encoded_size() const {
+    uint8_t size = 1;
+    for (uint64_t val = this->value_ >> 7; val != 0; val >>= 7)
+      size++;
+    return size;
+  }
+  /// Encode into `out`, which must have room for encoded_size() bytes.
+  void encode(uint8_t *out) const {
     uint64_t val = this->value_;
-    if (val <= 0x7F) {
-      out.push_back(val);
-      return;
-    }
-    while (val) {
-      uint8_t temp = val & 0x7F;
+    while (val > 0x7F) {
+      *out++ = (val & 0x7F) | 0x80;
       val >>= 7;
-      if (val) {
-        out.push_back(temp | 0x80);
-      } else {
-        out.push_back(temp);
-      }
     }
+    *out = val;
+  }
+  void encode(std::vector<uint8_t> &out) {
+    const size_t pos = out.size();
+    out.resize(pos + this->encoded_size());
+    this->encode(&out[pos]);
   }
 
  protected:
@@ -96,11 +102,15 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// View into the decoded buffer, only valid as long as that buffer (usually until the message handler returns).
+  StringRef as_string_ref() const { return StringRef(this->value_, this->length_); }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
     return msg;
   }
+  /// Decode into an existing message, merging with the fields it already has.
+  template<class C> void decode_to_message(C &msg) const { msg.decode(this->value_, this->length_); }
 
  protected:
   const uint8_t *const value_;
@@ -160,11 +170,13 @@ class ProtoWriteBuffer {
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
     auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
+  }
+  void encode_string(uint32_t field_id, const StringRef &value, bool force = false) {
+    this->encode_string(field_id, value.c_str(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -223,7 +235,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -256,15 +268,11 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // the length prefix is known up front, so the nested message is encoded in place
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -272,10 +280,92 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Encoded sizes of message fields, used by the generated calculate_size() methods.
+ *
+ * Every add_*() method adds exactly what the encode_*() method of ProtoWriteBuffer with the same arguments writes
+ * (including the rules for skipping default values), so a message can be sized without encoding it.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) { return ProtoVarInt(value).encoded_size(); }
+  static uint32_t varint(uint64_t value) { return ProtoVarInt(value).encoded_size(); }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_string(uint32_t &total_size, uint32_t field_id, size_t len, bool force = false) {
+    if (len == 0 && !force)
+      return;
+    total_size += field(field_id, 2) + varint(static_cast<uint32_t>(len)) + len;
+  }
+  static void add_string(uint32_t &total_size, uint32_t field_id, const std::string &value, bool force = false) {
+    add_string(total_size, field_id, value.size(), force);
+  }
+  static void add_string(uint32_t &total_size, uint32_t field_id, const StringRef &value, bool force = false) {
+    add_string(total_size, field_id, value.size(), force);
+  }
+  static void add_uint32(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_bool(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_fixed64(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 8;
+  }
+  template<typename T> static void add_enum(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_float(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_int32(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    add_uint32(total_size, field_id, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  static void add_sint64(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64(total_size, field_id, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  template<class C>
+  static void add_message(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() writes to `total_size`.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -299,12 +389,15 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Start a new message, `reserve_size` is the expected encoded size so that the buffer only grows once.
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -0,0 +1,31 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, PLATFORM_HOST
+
+AUTO_LOAD = ["json"]
+
+CONF_ITERATION_SCALE = "iteration_scale"
+CONF_EXIT_WHEN_DONE = "exit_when_done"
+
+benchmark_ns = cg.esphome_ns.namespace("benchmark")
+BenchmarkComponent = benchmark_ns.class_("BenchmarkComponent", cg.Component)
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(BenchmarkComponent),
+            cv.Optional(CONF_ITERATION_SCALE, default=1.0): cv.float_range(
+                min=0, min_included=False
+            ),
+            cv.Optional(CONF_EXIT_WHEN_DONE, default=True): cv.boolean,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on(PLATFORM_HOST),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iteration_scale(config[CONF_ITERATION_SCALE]))
+    cg.add(var.set_exit_when_done(config[CONF_EXIT_WHEN_DONE]))
@@ -0,0 +1,921 @@
+#include "benchmark.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/scheduler.h"
+#include "esphome/core/version.h"
+#include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/sensor/filter.h"
+#endif
+#ifdef USE_API
+#include "esphome/components/api/api_pb2.h"
+#endif
+
+namespace esphome {
+namespace benchmark {
+
+static const char *const TAG = "benchmark";
+
+static const uint8_t NUM_NAMES = 64;
+static const uint8_t NUM_COMPONENTS = 64;
+
+// Results of the benchmarked code end up here so that the compiler cannot optimize the work away.
+static volatile uint32_t sink = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+namespace {
+/// A looping component that does (almost) nothing, to measure the per-component cost of the main loop.
+class NopComponent : public Component {
+ public:
+  void loop() override { this->count_++; }
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+ protected:
+  uint32_t count_{0};
+};
+
+/// CallbackManager as it was before it stored small callables inline: a list of std::function. Kept as a baseline
+/// for the callback benchmarks.
+template<typename... Ts> class StdFunctionCallbackManager {
+ public:
+  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  void call(Ts... args) {
+    for (auto &cb : this->callbacks_)
+      cb(args...);
+  }
+  size_t size() const { return this->callbacks_.size(); }
+
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+/// What the API, MQTT and web server callbacks usually capture.
+struct CallbackTarget {
+  void on_state(const void *obj, float value) { this->count += static_cast<uint32_t>(value) + (obj != nullptr); }
+  uint32_t count{0};
+};
+
+/// The timeout handling of the scheduler as it was before the timing wheel: a binary heap of individually allocated
+/// items, where cancelling scans every pending item and cancelled items are removed lazily. Kept as a baseline for
+/// the scheduler benchmarks.
+class HeapScheduler {
+ public:
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func) {
+    if (!name.empty())
+      this->cancel_timeout(component, name);
+    auto item = make_unique<Item>();
+    item->component = component;
+    item->name = name;
+    item->next_execution = this->now_ + timeout;
+    item->callback = std::move(func);
+    this->to_add_.push_back(std::move(item));
+  }
+  bool cancel_timeout(Component *component, const std::string &name) {
+    bool ret = false;
+    for (auto &item : this->items_) {
+      if (item->component == component && item->name == name && !item->remove) {
+        this->to_remove_++;
+        item->remove = true;
+        ret = true;
+      }
+    }
+    for (auto &item : this->to_add_) {
+      if (item->component == component && item->name == name) {
+        item->remove = true;
+        ret = true;
+      }
+    }
+    return ret;
+  }
+  void call() {
+    this->process_to_add_();
+    if (this->to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
+      std::vector<std::unique_ptr<Item>> valid_items;
+      while (!this->empty_()) {
+        valid_items.push_back(std::move(this->items_[0]));
+        this->pop_();
+      }
+      this->items_ = std::move(valid_items);
+    }
+    while (!this->empty_() && this->items_[0]->next_execution <= this->now_) {
+      this->items_[0]->callback();
+      this->pop_();
+    }
+    this->process_to_add_();
+  }
+
+ protected:
+  static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+
+  struct Item {
+    Component *component;
+    std::string name;
+    uint64_t next_execution;
+    std::function<void()> callback;
+    bool remove{false};
+  };
+
+  static bool cmp_(const std::unique_ptr<Item> &a, const std::unique_ptr<Item> &b) {
+    return a->next_execution > b->next_execution;
+  }
+  void process_to_add_() {
+    for (auto &item : this->to_add_) {
+      if (item->remove)
+        continue;
+      this->items_.push_back(std::move(item));
+      std::push_heap(this->items_.begin(), this->items_.end(), cmp_);
+    }
+    this->to_add_.clear();
+  }
+  void pop_() {
+    std::pop_heap(this->items_.begin(), this->items_.end(), cmp_);
+    this->items_.pop_back();
+  }
+  bool empty_() {
+    while (!this->items_.empty() && this->items_[0]->remove) {
+      this->to_remove_--;
+      this->pop_();
+    }
+    return this->items_.empty();
+  }
+
+  std::vector<std::unique_ptr<Item>> items_;
+  std::vector<std::unique_ptr<Item>> to_add_;
+  uint32_t to_remove_{0};
+  /// Time does not move during the benchmarks, only timeouts of 0 are due.
+  uint64_t now_{0};
+};
+
+#ifdef USE_SENSOR
+/// The median/quantile/min/max filters as they were before they kept their window sorted incrementally: every
+/// output copies the window without NaNs and sorts (or scans) it. Kept as a baseline for the filter benchmarks and as
+/// the reference the incremental filters are checked against.
+class SortingWindowFilter : public sensor::Filter {
+ public:
+  enum Mode { MEDIAN, QUANTILE, MIN, MAX };
+  SortingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at, Mode mode, float quantile = 0.9f)
+      : window_size_(window_size),
+        send_every_(send_every),
+        send_at_(send_every - send_first_at),
+        mode_(mode),
+        quantile_(quantile) {}
+
+  optional<float> new_value(float value) override {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+    if (++this->send_at_ < this->send_every_)
+      return {};
+    this->send_at_ = 0;
+    if (this->mode_ == MIN || this->mode_ == MAX) {
+      float result = NAN;
+      for (auto v : this->queue_) {
+        if (!std::isnan(v))
+          result = std::isnan(result) ? v : this->mode_ == MIN ? std::min(result, v) : std::max(result, v);
+      }
+      return result;
+    }
+    std::vector<float> sorted;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        sorted.push_back(v);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted.empty())
+      return NAN;
+    if (this->mode_ == QUANTILE)
+      return sorted[ceilf(sorted.size() * this->quantile_) - 1];
+    const size_t size = sorted.size();
+    return size % 2 ? sorted[size / 2] : (sorted[size / 2] + sorted[size / 2 - 1]) / 2.0f;
+  }
+
+ protected:
+  std::deque<float> queue_;
+  size_t window_size_;
+  size_t send_every_;
+  size_t send_at_;
+  Mode mode_;
+  float quantile_;
+};
+
+/// The sliding window moving average filter as it was before it kept a running sum: every output sums the window.
+/// Kept as the reference the running sum is checked against.
+class DequeMovingAverageFilter : public sensor::Filter {
+ public:
+  DequeMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at)
+      : window_size_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
+
+  optional<float> new_value(float value) override {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+    if (++this->send_at_ < this->send_every_)
+      return {};
+    this->send_at_ = 0;
+    float sum = 0;
+    size_t valid_count = 0;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v)) {
+        sum += v;
+        valid_count++;
+      }
+    }
+    return valid_count ? sum / valid_count : NAN;
+  }
+
+ protected:
+  std::deque<float> queue_;
+  size_t window_size_;
+  size_t send_every_;
+  size_t send_at_;
+};
+
+/// Random sensor values in [-50, 150), with some NaN and inf among them.
+std::vector<float> random_states(std::minstd_rand &rng, size_t count) {
+  std::vector<float> states(count);
+  for (auto &state : states) {
+    state = float(rng() % 20000) / 100.0f - 50.0f;
+    if (rng() % 97 == 0)
+      state = rng() % 2 ? NAN : INFINITY;
+  }
+  return states;
+}
+
+/// What a filter outputs for each of `values`, NaN where it drops the value, followed by whether it dropped it. Both
+/// are compared, so that a filter that sends NaN is told apart from one that sends nothing.
+std::vector<float> filter_outputs(sensor::Filter *filter, const std::vector<float> &values) {
+  std::vector<float> outputs;
+  for (float value : values) {
+    const optional<float> out = filter->new_value(value);
+    outputs.push_back(out.value_or(NAN));
+    outputs.push_back(out.has_value());
+  }
+  return outputs;
+}
+
+/// Whether two sensors sent the same states, comparing bit patterns so that NaN equals NaN.
+bool same_states(const std::vector<float> &a, const std::vector<float> &b) {
+  return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+/// Whether two sensors sent the same states up to rounding errors: NaN and inf where the other one did, and finite
+/// states that are within `tolerance` of each other.
+bool close_states(const std::vector<float> &a, const std::vector<float> &b, float tolerance) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    bool close;
+    if (std::isfinite(a[i]) && std::isfinite(b[i])) {
+      close = std::fabs(a[i] - b[i]) <= tolerance;
+    } else {
+      close = std::isnan(a[i]) ? std::isnan(b[i]) : a[i] == b[i];
+    }
+    if (!close)
+      return false;
+  }
+  return true;
+}
+#endif
+}  // namespace
+
+void BenchmarkComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Benchmark:");
+  ESP_LOGCONFIG(TAG, "  Iteration Scale: %.2f", this->iteration_scale_);
+  ESP_LOGCONFIG(TAG, "  Exit When Done: %s", YESNO(this->exit_when_done_));
+}
+
+void BenchmarkComponent::loop() {
+  ESP_LOGI(TAG, "Running benchmarks...");
+  printf("{\"esphome_version\":\"%s\",\"compilation_time\":\"%s\"}\n", ESPHOME_VERSION,
+         App.get_compilation_time().c_str());
+
+  this->run_scheduler_();
+  this->run_component_loop_();
+  this->run_callback_manager_();
+#ifdef USE_SENSOR
+  this->run_sensor_filters_();
+#endif
+#ifdef USE_API
+  this->run_protobuf_();
+#endif
+  this->run_json_();
+
+  fflush(stdout);
+  ESP_LOGI(TAG, "Benchmarks done");
+  if (this->exit_when_done_)
+    exit(this->failed_ ? 1 : 0);  // NOLINT(concurrency-mt-unsafe)
+  this->disable_loop();
+}
+
+void BenchmarkComponent::report_(const char *name, uint64_t operations, uint64_t total_ns) {
+  printf("{\"benchmark\":\"%s\",\"iterations\":%" PRIu64 ",\"total_us\":%" PRIu64 ",\"ns_per_op\":%.2f}\n", name,
+         operations, total_ns / 1000, double(total_ns) / double(operations));
+}
+
+void BenchmarkComponent::check_(const char *name, bool passed) {
+  printf("{\"check\":\"%s\",\"passed\":%s}\n", name, passed ? "true" : "false");
+  if (!passed) {
+    ESP_LOGE(TAG, "Check %s failed", name);
+    this->failed_ = true;
+  }
+}
+
+void BenchmarkComponent::run_scheduler_() {
+  Scheduler scheduler;
+  this->run_scheduler_cases_(scheduler, "scheduler");
+  HeapScheduler heap_scheduler;
+  this->run_scheduler_cases_(heap_scheduler, "scheduler_heap");
+}
+
+template<typename S> void BenchmarkComponent::run_scheduler_cases_(S &scheduler, const std::string &prefix) {
+  NopComponent component;
+  std::vector<std::string> names;
+  for (uint8_t i = 0; i < NUM_NAMES; i++)
+    names.push_back("timer_" + to_string(i));
+
+  // replaces one of NUM_NAMES pending named timeouts on every call
+  this->run_((prefix + ".set_timeout").c_str(), 200000, [&](uint32_t i) {
+    scheduler.set_timeout(&component, names[i % NUM_NAMES], 60000, []() { sink = sink + 1; });
+  });
+  this->run_((prefix + ".cancel_and_set_timeout").c_str(), 200000, [&](uint32_t i) {
+    const std::string &name = names[i % NUM_NAMES];
+    sink = sink + scheduler.cancel_timeout(&component, name);
+    scheduler.set_timeout(&component, name, 60000, []() { sink = sink + 1; });
+  });
+  // call() with NUM_NAMES timers pending but none due
+  this->run_((prefix + ".call_idle").c_str(), 200000, [&](uint32_t i) { scheduler.call(); });
+  // NUM_NAMES due timeouts per call(), each one is scheduled and run
+  this->run_(
+      (prefix + ".run_timeout").c_str(), 5000,
+      [&](uint32_t i) {
+        for (uint8_t j = 0; j < NUM_NAMES; j++)
+          scheduler.set_timeout(&component, "", 0, []() { sink = sink + 1; });
+        scheduler.call();
+      },
+      NUM_NAMES);
+  for (auto &name : names)
+    scheduler.cancel_timeout(&component, name);
+  scheduler.call();
+}
+
+void BenchmarkComponent::run_component_loop_() {
+  std::vector<std::unique_ptr<NopComponent>> components;
+  for (uint8_t i = 0; i < NUM_COMPONENTS; i++) {
+    components.emplace_back(new NopComponent());  // NOLINT(cppcoreguidelines-owning-memory)
+    components.back()->call();                    // setup()
+  }
+  // the per-component body of Application::loop()
+  this->run_(
+      "application.loop_per_component", 20000,
+      [&](uint32_t i) {
+        uint32_t app_state = 0;
+        for (auto &component : components) {
+          {
+            WarnIfComponentBlockingGuard guard{component.get()};
+            component->call();
+          }
+          app_state |= component->get_component_state();
+          App.feed_wdt();
+        }
+        sink = sink + app_state;
+      },
+      NUM_COMPONENTS);
+}
+
+void BenchmarkComponent::run_callback_manager_() {
+  CallbackManager<void(float)> callbacks;
+  for (uint8_t i = 0; i < 4; i++)
+    callbacks.add([](float value) { sink = sink + static_cast<uint32_t>(value); });
+  this->run_("callback_manager.call_4", 1000000, [&](uint32_t i) { callbacks.call(float(i)); });
+
+  this->run_("callback_manager.add", 200000, [&](uint32_t i) {
+    CallbackManager<void(float)> manager;
+    manager.add([](float value) { sink = sink + static_cast<uint32_t>(value); });
+    sink = sink + manager.size();
+  });
+
+  // an entity with the callbacks of the API, MQTT, web server and a few automations, each capturing two pointers
+  CallbackTarget target;
+  const void *obj = &target;
+  CallbackManager<void(float)> entity;
+  StdFunctionCallbackManager<float> entity_std_function;
+  for (uint8_t i = 0; i < 8; i++) {
+    entity.add([&target, obj](float value) { target.on_state(obj, value); });
+    entity_std_function.add([&target, obj](float value) { target.on_state(obj, value); });
+  }
+  this->run_("callback_manager.call_8_captures", 500000, [&](uint32_t i) { entity.call(float(i)); }, 8);
+  this->run_(
+      "callback_manager.call_8_captures_std_function", 500000,
+      [&](uint32_t i) { entity_std_function.call(float(i)); }, 8);
+  this->run_(
+      "callback_manager.add_8_captures", 50000,
+      [&](uint32_t i) {
+        CallbackManager<void(float)> manager;
+        for (uint8_t j = 0; j < 8; j++)
+          manager.add([&target, obj](float value) { target.on_state(obj, value); });
+        sink = sink + manager.size();
+      },
+      8);
+  this->run_(
+      "callback_manager.add_8_captures_std_function", 50000,
+      [&](uint32_t i) {
+        StdFunctionCallbackManager<float> manager;
+        for (uint8_t j = 0; j < 8; j++)
+          manager.add([&target, obj](float value) { target.on_state(obj, value); });
+        sink = sink + manager.size();
+      },
+      8);
+  sink = sink + target.count;
+
+  // bytes per callback in the list, not counting anything the callables allocate themselves
+  printf("{\"memory\":\"callback_manager\",\"bytes_per_callback\":%u,\"std_function_bytes_per_callback\":%u}\n",
+         unsigned(2 * sizeof(void *) + sizeof(void (*)())), unsigned(sizeof(std::function<void(float)>)));
+}
+
+#ifdef USE_SENSOR
+void BenchmarkComponent::check_sensor_batches_() {
+  // chains with filters that filter batches in a loop of their own and ones that use the per-value fallback, each
+  // also dropping values on the way
+  using ChainFactory = std::vector<sensor::Filter *> (*)();
+  static const std::pair<const char *, ChainFactory> CHAINS[] = {
+      {"sensor.publish_states.affine",
+       []() -> std::vector<sensor::Filter *> {
+         // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+         auto *linear = new sensor::CalibrateLinearFilter({{2.0f, 1.0f, 10.0f}, {0.5f, 16.0f, NAN}});
+         return {
+             linear,
+             new sensor::MultiplyFilter(1.5f),                            // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::OffsetFilter(-3.0f),                             // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::CalibratePolynomialFilter({1.0f, 0.5f, 0.01f}),  // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::ClampFilter(-20.0f, 80.0f, true),                // NOLINT(cppcoreguidelines-owning-memory)
+         };
+       }},
+      {"sensor.publish_states.sliding_window",
+       []() -> std::vector<sensor::Filter *> {
+         return {
+             new sensor::SlidingWindowMovingAverageFilter(15, 3, 1),  // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::DeltaFilter(0.1f, false),                    // NOLINT(cppcoreguidelines-owning-memory)
+         };
+       }},
+      {"sensor.publish_states.exponential",
+       []() -> std::vector<sensor::Filter *> {
+         return {
+             new sensor::ExponentialMovingAverageFilter(0.2f, 2, 1),  // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::ClampFilter(0.0f, 100.0f, false),            // NOLINT(cppcoreguidelines-owning-memory)
+         };
+       }},
+      {"sensor.publish_states.fallback",
+       []() -> std::vector<sensor::Filter *> {
+         return {
+             new sensor::MedianFilter(5, 1, 1),       // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::OffsetFilter(2.0f),          // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::SkipInitialFilter(7),        // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::FilterOutValueFilter(5.0f),  // NOLINT(cppcoreguidelines-owning-memory)
+             new sensor::MultiplyFilter(-1.0f),       // NOLINT(cppcoreguidelines-owning-memory)
+         };
+       }},
+  };
+
+  // a fixed seed, so that a failure can be reproduced
+  std::minstd_rand rng(1);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  const std::vector<float> values = random_states(rng, 10000);
+
+  for (const auto &chain : CHAINS) {
+    std::vector<float> single_states, batched_states;
+    sensor::Sensor single, batched;
+    single.add_filters(chain.second());
+    batched.add_filters(chain.second());
+    single.add_on_state_callback([&single_states](float state) { single_states.push_back(state); });
+    batched.add_on_state_callback([&batched_states](float state) { batched_states.push_back(state); });
+
+    for (float value : values)
+      single.publish_state(value);
+    std::vector<float> block;
+    for (size_t i = 0; i < values.size();) {
+      const size_t count = std::min<size_t>(1 + rng() % 64, values.size() - i);
+      block.assign(values.begin() + i, values.begin() + i + count);
+      batched.publish_states(block.data(), count);
+      i += count;
+    }
+
+    this->check_(chain.first, same_states(single_states, batched_states));
+  }
+}
+
+void BenchmarkComponent::check_fused_filters_() {
+  sensor::Sensor separate;
+  separate.add_filters({
+      new sensor::OffsetFilter(2.0f),    // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::MultiplyFilter(1.2f),  // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::LambdaFilter([](float x) -> optional<float> {  // NOLINT(cppcoreguidelines-owning-memory)
+        if (x > 100.0f)
+          return {};
+        return x * 0.5f;
+      }),
+      // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+      new sensor::CalibrateLinearFilter({{1.125f, 0.0f, 40.0f}, {0.9583333333333334f, 6.666666666666664f, NAN}}),
+      new sensor::ClampFilter(0.0f, 100.0f, false),  // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::RoundFilter(1),                    // NOLINT(cppcoreguidelines-owning-memory)
+  });
+
+  // what build_filters() generates for the same filters, kept in sync by the sensor unit tests
+  sensor::Sensor fused;
+  fused.add_filter(sensor::make_fused_filter([=](float x) -> optional<float> {
+    x = x + 2.0f;
+    x = x * 1.2f;
+    {
+      const optional<float> result = ([=](float x) -> optional<float> {
+        if (x > 100.0f)
+          return {};
+        return x * 0.5f;
+      })(x);
+      if (!result.has_value())
+        return {};
+      x = *result;
+    }
+    if (x < 40.0f)
+      x = (x * 1.125f) + 0.0f;
+    else
+      x = (x * 0.9583333333333334f) + 6.666666666666664f;
+    if (std::isfinite(x) && x < 0.0f)
+      x = 0.0f;
+    if (std::isfinite(x) && x > 100.0f)
+      x = 100.0f;
+    if (std::isfinite(x)) {
+      const float accuracy_mult = powf(10.0f, 1);
+      x = roundf(accuracy_mult * x) / accuracy_mult;
+    }
+    return x;
+  }));
+
+  std::vector<float> separate_states, fused_states;
+  separate.add_on_state_callback([&separate_states](float state) { separate_states.push_back(state); });
+  fused.add_on_state_callback([&fused_states](float state) { fused_states.push_back(state); });
+  std::minstd_rand rng(2);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  for (float value : random_states(rng, 100000)) {
+    separate.publish_state(value);
+    fused.publish_state(value);
+  }
+  this->check_("sensor.fused_filter", same_states(separate_states, fused_states));
+}
+
+void BenchmarkComponent::check_window_filters_() {
+  struct WindowCase {
+    const char *name;
+    SortingWindowFilter::Mode mode;
+    size_t window_size;
+    size_t send_every;
+    size_t send_first_at;
+    float quantile;
+  };
+  static const WindowCase CASES[] = {
+      {"sensor.window_median_1", SortingWindowFilter::MEDIAN, 1, 1, 1, 0.5f},
+      {"sensor.window_median_odd", SortingWindowFilter::MEDIAN, 5, 1, 1, 0.5f},
+      {"sensor.window_median_even", SortingWindowFilter::MEDIAN, 6, 1, 1, 0.5f},
+      {"sensor.window_median_100", SortingWindowFilter::MEDIAN, 100, 1, 1, 0.5f},
+      {"sensor.window_median_send_every", SortingWindowFilter::MEDIAN, 7, 3, 2, 0.5f},
+      {"sensor.window_quantile_low", SortingWindowFilter::QUANTILE, 9, 1, 1, 0.1f},
+      {"sensor.window_quantile_high", SortingWindowFilter::QUANTILE, 100, 1, 1, 0.9f},
+      {"sensor.window_quantile_max", SortingWindowFilter::QUANTILE, 8, 1, 1, 1.0f},
+      {"sensor.window_quantile_send_every", SortingWindowFilter::QUANTILE, 20, 4, 1, 0.75f},
+      {"sensor.window_min", SortingWindowFilter::MIN, 10, 1, 1, 0.0f},
+      {"sensor.window_min_send_every", SortingWindowFilter::MIN, 100, 5, 3, 0.0f},
+      {"sensor.window_max", SortingWindowFilter::MAX, 10, 1, 1, 0.0f},
+      {"sensor.window_max_send_every", SortingWindowFilter::MAX, 100, 5, 3, 0.0f},
+  };
+
+  // a fixed seed, so that a failure can be reproduced
+  std::minstd_rand rng(3);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  // the windows start out empty, so the first outputs are of windows that aren't full yet
+  std::vector<float> values = random_states(rng, 20000);
+  // runs of NaN, some longer than any window, so that windows hold only NaN
+  for (size_t i = 0; i < values.size(); i += 500 + rng() % 500) {
+    const size_t end = std::min<size_t>(i + 1 + rng() % 150, values.size());
+    std::fill(values.begin() + i, values.begin() + end, NAN);
+  }
+  // few distinct values, so that windows hold many equal ones
+  for (size_t i = 10000; i < 12000; i++) {
+    if (!std::isnan(values[i]))
+      values[i] = float(rng() % 4);
+  }
+
+  for (const auto &window_case : CASES) {
+    const size_t window_size = window_case.window_size;
+    const size_t send_every = window_case.send_every;
+    const size_t send_first_at = window_case.send_first_at;
+    std::unique_ptr<sensor::Filter> filter;
+    switch (window_case.mode) {
+      case SortingWindowFilter::MEDIAN:
+        filter = make_unique<sensor::MedianFilter>(window_size, send_every, send_first_at);
+        break;
+      case SortingWindowFilter::QUANTILE:
+        filter = make_unique<sensor::QuantileFilter>(window_size, send_every, send_first_at, window_case.quantile);
+        break;
+      case SortingWindowFilter::MIN:
+        filter = make_unique<sensor::MinFilter>(window_size, send_every, send_first_at);
+        break;
+      case SortingWindowFilter::MAX:
+        filter = make_unique<sensor::MaxFilter>(window_size, send_every, send_first_at);
+        break;
+    }
+    SortingWindowFilter reference(window_size, send_every, send_first_at, window_case.mode, window_case.quantile);
+    const std::vector<float> expected = filter_outputs(&reference, values);
+    this->check_(window_case.name, same_states(filter_outputs(filter.get(), values), expected));
+  }
+}
+
+void BenchmarkComponent::check_moving_average_() {
+  // a fixed seed, so that a failure can be reproduced
+  std::minstd_rand rng(4);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::vector<float> values = random_states(rng, 20000);
+  // both signs of inf, so that some windows hold both
+  for (auto &value : values) {
+    if (std::isinf(value) && rng() % 2)
+      value = -INFINITY;
+  }
+
+  sensor::Sensor single, batched, reference;
+  single.add_filter(new sensor::SlidingWindowMovingAverageFilter(15, 2, 1));  // NOLINT(cppcoreguidelines-owning-memory)
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  batched.add_filter(new sensor::SlidingWindowMovingAverageFilter(15, 2, 1));
+  reference.add_filter(new DequeMovingAverageFilter(15, 2, 1));  // NOLINT(cppcoreguidelines-owning-memory)
+  std::vector<float> single_states, batched_states, reference_states;
+  single.add_on_state_callback([&single_states](float state) { single_states.push_back(state); });
+  batched.add_on_state_callback([&batched_states](float state) { batched_states.push_back(state); });
+  reference.add_on_state_callback([&reference_states](float state) { reference_states.push_back(state); });
+
+  for (float value : values) {
+    single.publish_state(value);
+    reference.publish_state(value);
+  }
+  std::vector<float> block;
+  for (size_t i = 0; i < values.size();) {
+    const size_t count = std::min<size_t>(1 + rng() % 64, values.size() - i);
+    block.assign(values.begin() + i, values.begin() + i + count);
+    batched.publish_states(block.data(), count);
+    i += count;
+  }
+
+  // the running sum rounds differently than summing the window, the values are in [-50, 150)
+  this->check_("sensor.moving_average", close_states(single_states, reference_states, 1e-3f));
+  this->check_("sensor.moving_average.batched", close_states(batched_states, reference_states, 1e-3f));
+}
+
+void BenchmarkComponent::run_sensor_filters_() {
+  this->check_sensor_batches_();
+  this->check_fused_filters_();
+  this->check_window_filters_();
+  this->check_moving_average_();
+
+  sensor::Sensor plain;
+  plain.add_on_state_callback([](float value) { sink = sink + 1; });
+  this->run_("sensor.publish_state", 500000, [&](uint32_t i) { plain.publish_state(float(i % 100)); });
+
+  // a typical chain: calibration, smoothing and deduplication
+  sensor::Sensor filtered;
+  filtered.add_filters({
+      new sensor::MultiplyFilter(1.5f),                        // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::OffsetFilter(-3.0f),                         // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::SlidingWindowMovingAverageFilter(15, 1, 1),  // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::DeltaFilter(0.1f, false),                    // NOLINT(cppcoreguidelines-owning-memory)
+  });
+  filtered.add_on_state_callback([](float value) { sink = sink + 1; });
+  this->run_("sensor.filter_chain", 500000, [&](uint32_t i) { filtered.publish_state(float(i % 100)); });
+
+  // the same chain, fed BATCH_SIZE values at a time
+  static const uint32_t BATCH_SIZE = 64;
+  sensor::Sensor batched;
+  batched.add_filters({
+      new sensor::MultiplyFilter(1.5f),                        // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::OffsetFilter(-3.0f),                         // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::SlidingWindowMovingAverageFilter(15, 1, 1),  // NOLINT(cppcoreguidelines-owning-memory)
+      new sensor::DeltaFilter(0.1f, false),                    // NOLINT(cppcoreguidelines-owning-memory)
+  });
+  batched.add_on_state_callback([](float value) { sink = sink + 1; });
+  float batch[BATCH_SIZE];
+  this->run_(
+      "sensor.filter_chain_batch_64", 500000 / BATCH_SIZE,
+      [&](uint32_t i) {
+        for (uint32_t j = 0; j < BATCH_SIZE; j++)
+          batch[j] = float((i * BATCH_SIZE + j) % 100);
+        batched.publish_states(batch, BATCH_SIZE);
+      },
+      BATCH_SIZE);
+
+  sensor::Sensor median;
+  median.add_filters({new sensor::MedianFilter(15, 1, 1)});  // NOLINT(cppcoreguidelines-owning-memory)
+  median.add_on_state_callback([](float value) { sink = sink + 1; });
+  this->run_("sensor.median_15", 200000, [&](uint32_t i) { median.publish_state(float((i * 7919) % 100)); });
+
+  // windowed filters that output on every value, each next to the baseline that sorts or scans the window
+  sensor::MedianFilter median_100(100, 1, 1);
+  SortingWindowFilter median_100_sorting(100, 1, 1, SortingWindowFilter::MEDIAN);
+  sensor::QuantileFilter quantile_100(100, 1, 1, 0.9f);
+  SortingWindowFilter quantile_100_sorting(100, 1, 1, SortingWindowFilter::QUANTILE);
+  sensor::MinFilter min_100(100, 1, 1);
+  SortingWindowFilter min_100_scanning(100, 1, 1, SortingWindowFilter::MIN);
+  const std::pair<const char *, sensor::Filter *> window_cases[] = {
+      {"filter.median_100", &median_100},     {"filter.median_100_sorting", &median_100_sorting},
+      {"filter.quantile_100", &quantile_100}, {"filter.quantile_100_sorting", &quantile_100_sorting},
+      {"filter.min_100", &min_100},           {"filter.min_100_scanning", &min_100_scanning},
+  };
+  for (const auto &window_case : window_cases) {
+    sensor::Filter *filter = window_case.second;
+    this->run_(window_case.first, 200000, [filter](uint32_t i) {
+      const optional<float> out = filter->new_value(float((i * 7919) % 1000));
+      sink = sink + static_cast<uint32_t>(*out);
+    });
+  }
+}
+#endif
+
+#ifdef USE_API
+void BenchmarkComponent::run_protobuf_() {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(1024);
+
+  api::SensorStateResponse state;
+  state.key = 0x12345678;
+  state.state = 23.5f;
+  this->run_("api.encode_sensor_state", 1000000, [&](uint32_t i) {
+    buffer.clear();
+    state.encode(api::ProtoWriteBuffer{&buffer});
+    sink = sink + buffer.size();
+  });
+
+  api::ListEntitiesSensorResponse info;
+  info.object_id = "living_room_temperature";
+  info.key = 0x12345678;
+  info.name = "Living Room Temperature";
+  info.unique_id = "aabbccddeeffsensorliving_room_temperature";
+  info.icon = "mdi:thermometer";
+  info.unit_of_measurement = "°C";
+  info.accuracy_decimals = 1;
+  info.device_class = "temperature";
+  info.state_class = api::enums::STATE_CLASS_MEASUREMENT;
+  this->run_("api.encode_list_entities_sensor", 500000, [&](uint32_t i) {
+    buffer.clear();
+    info.encode(api::ProtoWriteBuffer{&buffer});
+    sink = sink + buffer.size();
+  });
+  buffer.clear();
+  info.encode(api::ProtoWriteBuffer{&buffer});
+  std::vector<uint8_t> encoded_info = buffer;
+  this->run_("api.decode_list_entities_sensor", 500000, [&](uint32_t i) {
+    api::ListEntitiesSensorResponse msg;
+    msg.decode(encoded_info.data(), encoded_info.size());
+    sink = sink + msg.accuracy_decimals;
+  });
+
+  // the largest message, a full batch of raw BLE advertisements
+  api::BluetoothLERawAdvertisementsResponse advertisements;
+  for (uint8_t i = 0; i < 16; i++) {
+    api::BluetoothLERawAdvertisement adv;
+    adv.address = 0xAABBCCDDEE00ULL + i;
+    adv.rssi = -60 - i;
+    adv.address_type = i % 2;
+    adv.data = std::string(31, static_cast<char>(i));
+    advertisements.advertisements.push_back(adv);
+  }
+  this->run_("api.encode_ble_raw_advertisements_16", 100000, [&](uint32_t i) {
+    buffer.clear();
+    advertisements.encode(api::ProtoWriteBuffer{&buffer});
+    sink = sink + buffer.size();
+  });
+
+  // one state update sent to 1, 4 and 8 subscribed clients, each with its own frame buffer
+  static const uint8_t FRAME_HEADER_SIZE = 6;
+  std::vector<uint8_t> client_buffers[8];
+  for (uint8_t clients : {1, 4, 8}) {
+    char name[48];
+    // as before: every client builds and encodes the message into its own buffer
+    snprintf(name, sizeof(name), "api.state_fanout_%u_per_client", clients);
+    this->run_(name, 200000, [&](uint32_t i) {
+      for (uint8_t c = 0; c < clients; c++) {
+        api::SensorStateResponse msg;
+        msg.key = 0x12345678;
+        msg.state = float(i % 100);
+        msg.missing_state = false;
+        std::vector<uint8_t> &client_buffer = client_buffers[c];
+        client_buffer.resize(FRAME_HEADER_SIZE);
+        msg.encode(api::ProtoWriteBuffer{&client_buffer});
+        sink = sink + client_buffer.size();
+      }
+    });
+    // as the API server does now: build and encode once, then copy the payload into every client's frame
+    snprintf(name, sizeof(name), "api.state_fanout_%u_shared", clients);
+    this->run_(name, 200000, [&](uint32_t i) {
+      api::SensorStateResponse msg;
+      msg.key = 0x12345678;
+      msg.state = float(i % 100);
+      msg.missing_state = false;
+      uint32_t msg_size = 0;
+      msg.calculate_size(msg_size);
+      buffer.clear();
+      buffer.reserve(msg_size);
+      msg.encode(api::ProtoWriteBuffer{&buffer});
+      for (uint8_t c = 0; c < clients; c++) {
+        std::vector<uint8_t> &client_buffer = client_buffers[c];
+        client_buffer.resize(FRAME_HEADER_SIZE);
+        client_buffer.insert(client_buffer.end(), buffer.begin(), buffer.end());
+        sink = sink + client_buffer.size();
+      }
+    });
+  }
+
+  api::HomeAssistantStateResponse ha_state;
+  ha_state.entity_id = StringRef("sensor.outside_temperature");
+  ha_state.state = StringRef("12.5");
+  buffer.clear();
+  ha_state.encode(api::ProtoWriteBuffer{&buffer});
+  std::vector<uint8_t> encoded_ha_state = buffer;
+  this->run_("api.decode_home_assistant_state", 1000000, [&](uint32_t i) {
+    api::HomeAssistantStateResponse msg;
+    msg.decode(encoded_ha_state.data(), encoded_ha_state.size());
+    sink = sink + msg.state.size();
+  });
+}
+#endif
+
+void BenchmarkComponent::run_json_() {
+  this->run_("json.build_sensor_state", 100000, [&](uint32_t i) {
+    std::string json = json::build_json([i](JsonObject root) {
+      root["id"] = "sensor-living_room_temperature";
+      root["state"] = "23.5 °C";
+      root["value"] = 23.5f + float(i % 10);
+    });
+    sink = sink + json.size();
+  });
+  this->run_("json.write_sensor_state", 100000, [&](uint32_t i) {
+    std::string json = json::write_json([i](json::JsonObjectWriter root) {
+      root.add("id", "sensor-living_room_temperature");
+      root.add("state", "23.5 °C");
+      root.add("value", 23.5f + float(i % 10));
+    });
+    sink = sink + json.size();
+  });
+  this->run_("json.build_light_state", 20000, [&](uint32_t i) {
+    std::string json = json::build_json([i](JsonObject root) {
+      root["id"] = "light-living_room";
+      root["name"] = "Living Room";
+      root["state"] = "ON";
+      root["brightness"] = i % 256;
+      JsonObject color = root.createNestedObject("color");
+      color["r"] = 255;
+      color["g"] = 128;
+      color["b"] = 0;
+      JsonArray effects = root.createNestedArray("effects");
+      for (const char *effect : {"None", "Rainbow", "Strobe", "Flicker", "Random"})
+        effects.add(effect);
+    });
+    sink = sink + json.size();
+  });
+  this->run_("json.write_light_state", 20000, [&](uint32_t i) {
+    std::string json = json::write_json([i](json::JsonObjectWriter root) {
+      root.add("id", "light-living_room");
+      root.add("name", "Living Room");
+      root.add("state", "ON");
+      root.add("brightness", i % 256);
+      json::JsonObjectWriter color = root.create_nested_object("color");
+      color.add("r", 255);
+      color.add("g", 128);
+      color.add("b", 0);
+      json::JsonArrayWriter effects = root.create_nested_array("effects");
+      for (const char *effect : {"None", "Rainbow", "Strobe", "Flicker", "Random"})
+        effects.add(effect);
+    });
+    sink = sink + json.size();
+  });
+  std::string doc = json::build_json([](JsonObject root) {
+    root["state"] = "ON";
+    root["brightness"] = 255;
+    JsonObject color = root.createNestedObject("color");
+    color["r"] = 255;
+    color["g"] = 128;
+    color["b"] = 0;
+  });
+  this->run_("json.parse_light_command", 100000, [&](uint32_t i) {
+    json::parse_json(doc, [](JsonObject root) { sink = sink + root["brightness"].as<uint32_t>(); });
+  });
+}
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+
+namespace esphome {
+namespace benchmark {
+
+/** Measures the throughput of core runtime building blocks on the host platform.
+ *
+ * All cases run once from the first loop() (so that every other component is set up), and each result is printed
+ * as one JSON object per line on stdout:
+ *
+ *   {"benchmark":"scheduler.set_timeout","iterations":200000,"total_us":31337,"ns_per_op":156.69}
+ *
+ * Cases that need an optional component (api, sensor) only run when that component is part of the configuration.
+ *
+ * Where a case times a fast path next to the code it replaces, a check first makes sure both give the same results.
+ * Each check is printed as one line too, and a failed one makes the process exit with status 1:
+ *
+ *   {"check":"sensor.publish_states.affine","passed":true}
+ */
+class BenchmarkComponent : public Component {
+ public:
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  /// Multiply the iteration count of every case, to trade run time for stable results.
+  void set_iteration_scale(float iteration_scale) { this->iteration_scale_ = iteration_scale; }
+  /// Exit the process once all cases ran.
+  void set_exit_when_done(bool exit_when_done) { this->exit_when_done_ = exit_when_done; }
+
+ protected:
+  /// Run `func` the scaled number of times and report it, `ops_per_call` is the number of operations per call.
+  template<typename F> void run_(const char *name, uint32_t iterations, F &&func, uint32_t ops_per_call = 1) {
+    iterations = std::max<uint32_t>(1, iterations * this->iteration_scale_);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+      func(i);
+    const auto end = std::chrono::steady_clock::now();
+    this->report_(name, uint64_t(iterations) * ops_per_call,
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  void report_(const char *name, uint64_t operations, uint64_t total_ns);
+  void check_(const char *name, bool passed);
+
+  void run_scheduler_();
+  /// The scheduler cases, run against the scheduler and the heap-based baseline.
+  template<typename S> void run_scheduler_cases_(S &scheduler, const std::string &prefix);
+  void run_component_loop_();
+  void run_callback_manager_();
+#ifdef USE_SENSOR
+  void run_sensor_filters_();
+  /// Check that Sensor::publish_states() sends the same states as publish_state() for every sample.
+  void check_sensor_batches_();
+  /// Check that a FusedFilter as build_filters() generates it sends the same states as the filters it replaces.
+  void check_fused_filters_();
+  /// Check that the median, quantile, min and max filters send the same states as the ones that sort their window.
+  void check_window_filters_();
+  /// Check that the moving average with its running sum sends the same states as one that sums the window, also
+  /// around inf values.
+  void check_moving_average_();
+#endif
+#ifdef USE_API
+  void run_protobuf_();
+#endif
+  void run_json_();
+
+  float iteration_scale_{1.0f};
+  bool exit_when_done_{true};
+  bool failed_{false};
+};
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -27,6 +27,10 @@
 
 #endif  // USE_ESP32
 
+#ifdef USE_LOGGER_HISTORY
+#include "esphome/components/logger/logger.h"
+#endif
+
 #ifdef USE_ARDUINO
 #ifdef USE_RP2040
 #include <Arduino.h>
@@ -373,6 +377,11 @@ void DebugComponent::dump_config() {
   reset_reason = lt_get_reboot_reason_name(lt_get_reboot_reason());
 #endif  // USE_LIBRETINY
 
+#ifdef USE_LOGGER_HISTORY
+  // the reset ended the boot whose log lines the history kept
+  logger::global_logger->get_history().set_reset_reason(reset_reason);
+#endif
+
 #ifdef USE_TEXT_SENSOR
   if (this->device_info_ != nullptr) {
     if (device_info.length() > 255)
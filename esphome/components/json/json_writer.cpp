@@ -0,0 +1,182 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace esphome {
+namespace json {
+
+JsonObjectWriter JsonWriter::root() {
+  this->close_to_(0);
+  return JsonObjectWriter(this, this->open_('{'));
+}
+
+bool JsonWriter::begin_member_(uint8_t depth, uint32_t generation) {
+  if (depth == 0 || depth > this->depth_ || this->generations_[depth - 1] != generation)
+    return false;
+  // anything nested in the container is complete now
+  this->close_to_(depth);
+  const uint16_t bit = 1 << (depth - 1);
+  if (this->has_members_ & bit)
+    this->out_.push_back(',');
+  this->has_members_ |= bit;
+  return true;
+}
+
+bool JsonWriter::begin_member_(uint8_t depth, uint32_t generation, const char *key) {
+  if (!this->begin_member_(depth, generation))
+    return false;
+  this->out_.push_back('"');
+  this->out_.append(key);
+  this->out_.append("\":", 2);
+  return true;
+}
+
+uint8_t JsonWriter::open_(char bracket) {
+  if (this->depth_ == MAX_DEPTH) {
+    // keep the output valid, the members of the container are dropped
+    this->out_.append(bracket == '{' ? "{}" : "[]");
+    return 0;
+  }
+  this->out_.push_back(bracket);
+  const uint16_t bit = 1 << this->depth_;
+  if (bracket == '[') {
+    this->arrays_ |= bit;
+  } else {
+    this->arrays_ &= ~bit;
+  }
+  this->has_members_ &= ~bit;
+  this->generations_[this->depth_] = ++this->opened_;
+  return ++this->depth_;
+}
+
+void JsonWriter::close_to_(uint8_t depth) {
+  while (this->depth_ > depth) {
+    this->depth_--;
+    this->out_.push_back(this->arrays_ & (1 << this->depth_) ? ']' : '}');
+  }
+}
+
+void JsonWriter::write_string_(const char *str, size_t len) {
+  static const char *const HEX_DIGITS = "0123456789abcdef";
+  this->out_.push_back('"');
+  const char *run = str;
+  for (const char *end = str + len; str != end; str++) {
+    const auto c = static_cast<uint8_t>(*str);
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    // copy the run of characters that don't need escaping in one go
+    this->out_.append(run, str - run);
+    run = str + 1;
+    this->out_.push_back('\\');
+    switch (c) {
+      case '"':
+      case '\\':
+        this->out_.push_back(c);
+        break;
+      case '\b':
+        this->out_.push_back('b');
+        break;
+      case '\f':
+        this->out_.push_back('f');
+        break;
+      case '\n':
+        this->out_.push_back('n');
+        break;
+      case '\r':
+        this->out_.push_back('r');
+        break;
+      case '\t':
+        this->out_.push_back('t');
+        break;
+      default:
+        this->out_.append("u00", 3);
+        this->out_.push_back(HEX_DIGITS[c >> 4]);
+        this->out_.push_back(HEX_DIGITS[c & 0xF]);
+        break;
+    }
+  }
+  this->out_.append(run, str - run);
+  this->out_.push_back('"');
+}
+
+void JsonWriter::write_value_(const char *value) {
+  if (value == nullptr) {
+    this->out_.append("null");
+  } else {
+    this->write_string_(value, strlen(value));
+  }
+}
+
+void JsonWriter::write_unsigned_(uint64_t value) {
+  char buf[20];
+  char *pos = buf + sizeof(buf);
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->out_.append(pos, buf + sizeof(buf) - pos);
+}
+
+void JsonWriter::write_signed_(int64_t value) {
+  if (value < 0) {
+    this->out_.push_back('-');
+    // negate as unsigned so that the minimum value doesn't overflow
+    this->write_unsigned_(0 - static_cast<uint64_t>(value));
+  } else {
+    this->write_unsigned_(static_cast<uint64_t>(value));
+  }
+}
+
+void JsonWriter::write_float_(float value) {
+  if (!std::isfinite(value)) {
+    this->out_.append("null");
+    return;
+  }
+  // the shortest of 7 or 9 significant digits that reads back as the same float, "0.1" rather than "0.100000001"
+  char buf[24];
+  int len = snprintf(buf, sizeof(buf), "%.7g", value);
+  if (strtof(buf, nullptr) != value)
+    len = snprintf(buf, sizeof(buf), "%.9g", value);
+  this->out_.append(buf, len);
+}
+
+void JsonWriter::write_value_(double value) {
+  if (!std::isfinite(value)) {
+    this->out_.append("null");
+    return;
+  }
+  char buf[32];
+  int len = snprintf(buf, sizeof(buf), "%.15g", value);
+  if (strtod(buf, nullptr) != value)
+    len = snprintf(buf, sizeof(buf), "%.17g", value);
+  this->out_.append(buf, len);
+}
+
+JsonObjectWriter JsonObjectWriter::create_nested_object(const char *key) {
+  if (!this->writer_->begin_member_(this->depth_, this->generation_, key))
+    return JsonObjectWriter(this->writer_, 0);
+  return JsonObjectWriter(this->writer_, this->writer_->open_('{'));
+}
+
+JsonArrayWriter JsonObjectWriter::create_nested_array(const char *key) {
+  if (!this->writer_->begin_member_(this->depth_, this->generation_, key))
+    return JsonArrayWriter(this->writer_, 0);
+  return JsonArrayWriter(this->writer_, this->writer_->open_('['));
+}
+
+JsonObjectWriter JsonArrayWriter::create_nested_object() {
+  if (!this->writer_->begin_member_(this->depth_, this->generation_))
+    return JsonObjectWriter(this->writer_, 0);
+  return JsonObjectWriter(this->writer_, this->writer_->open_('{'));
+}
+
+JsonArrayWriter JsonArrayWriter::create_nested_array() {
+  if (!this->writer_->begin_member_(this->depth_, this->generation_))
+    return JsonArrayWriter(this->writer_, 0);
+  return JsonArrayWriter(this->writer_, this->writer_->open_('['));
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "esphome/core/string_ref.h"
+
+namespace esphome {
+namespace json {
+
+class JsonObjectWriter;
+class JsonArrayWriter;
+
+/** Writes JSON text straight into a string while the values are added, without building a document first.
+ *
+ * Containers are written in the order they are created: adding a value to a container closes the containers nested in
+ * it that are still open, so a nested object or array must be complete before its parent gets its next member. Adding
+ * to a container that is closed already does nothing. Keys are written as they are given, a key that is added twice
+ * shows up twice.
+ *
+ * NaN and infinite numbers are written as null, like ArduinoJson does.
+ */
+class JsonWriter {
+ public:
+  /// Append to \p out, which is the sink: a response body, an event or an MQTT payload.
+  explicit JsonWriter(std::string &out) : out_(out) {}
+  JsonWriter(const JsonWriter &) = delete;
+  JsonWriter &operator=(const JsonWriter &) = delete;
+  ~JsonWriter() { this->finish(); }
+
+  /// Open the root object.
+  JsonObjectWriter root();
+  /// Close all open containers, done automatically when the writer goes away.
+  void finish() { this->close_to_(0); }
+
+  /// Maximum nesting depth, deeper containers are dropped.
+  static const uint8_t MAX_DEPTH = 16;
+
+ protected:
+  friend JsonObjectWriter;
+  friend JsonArrayWriter;
+
+  /// Start a new member of the container at \p depth that was opened as \p generation, false if that container is
+  /// already closed.
+  bool begin_member_(uint8_t depth, uint32_t generation);
+  bool begin_member_(uint8_t depth, uint32_t generation, const char *key);
+  /// Open a container with \p bracket ('{' or '['), returns its depth or 0 if it's too deep.
+  uint8_t open_(char bracket);
+  /// The generation of the container open at \p depth, 0 for depth 0.
+  uint32_t generation_(uint8_t depth) const { return depth == 0 ? 0 : this->generations_[depth - 1]; }
+  void close_to_(uint8_t depth);
+
+  void write_string_(const char *str, size_t len);
+  void write_value_(const char *value);
+  void write_value_(const std::string &value) { this->write_string_(value.data(), value.size()); }
+  void write_value_(const StringRef &value) { this->write_string_(value.c_str(), value.size()); }
+  void write_value_(bool value) { this->out_.append(value ? "true" : "false"); }
+  void write_value_(std::nullptr_t /*value*/) { this->out_.append("null"); }
+  void write_value_(float value) { this->write_float_(value); }
+  void write_value_(double value);
+  void write_unsigned_(uint64_t value);
+  void write_signed_(int64_t value);
+  void write_float_(float value);
+  template<typename T,
+           typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+  void write_value_(T value) {
+    if (std::is_signed<T>::value) {
+      this->write_signed_(static_cast<int64_t>(value));
+    } else {
+      this->write_unsigned_(static_cast<uint64_t>(value));
+    }
+  }
+  template<typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0> void write_value_(T value) {
+    this->write_value_(static_cast<typename std::underlying_type<T>::type>(value));
+  }
+
+  std::string &out_;
+  /// Number of open containers.
+  uint8_t depth_{0};
+  /// Bit n is set if the container at depth n + 1 is an array.
+  uint16_t arrays_{0};
+  /// Bit n is set if the container at depth n + 1 has members.
+  uint16_t has_members_{0};
+  /// Number of containers opened so far. Each one is numbered with it, so that the handle of a closed container
+  /// can't add to a container that was opened at the same depth later.
+  uint32_t opened_{0};
+  /// The number of the container open at each depth.
+  uint32_t generations_[MAX_DEPTH]{};
+};
+
+/// An object that is being written by a JsonWriter, a small handle that can be passed by value.
+class JsonObjectWriter {
+ public:
+  /// Add a member. \p key is written as is and must not need escaping, like the constant keys in the code do.
+  template<typename T> void add(const char *key, const T &value) {
+    if (this->writer_->begin_member_(this->depth_, this->generation_, key))
+      this->writer_->write_value_(value);
+  }
+  void add(const char *key, const char *value) {
+    if (this->writer_->begin_member_(this->depth_, this->generation_, key))
+      this->writer_->write_value_(value);
+  }
+  /// Add a member whose value is already serialized JSON, e.g. a value of an ArduinoJson document.
+  void add_raw(const char *key, const std::string &json) {
+    if (this->writer_->begin_member_(this->depth_, this->generation_, key))
+      this->writer_->out_.append(json);
+  }
+  JsonObjectWriter create_nested_object(const char *key);
+  JsonArrayWriter create_nested_array(const char *key);
+
+ protected:
+  friend JsonWriter;
+  friend JsonArrayWriter;
+  JsonObjectWriter(JsonWriter *writer, uint8_t depth)
+      : writer_(writer), depth_(depth), generation_(writer->generation_(depth)) {}
+
+  JsonWriter *writer_;
+  uint8_t depth_;
+  uint32_t generation_;
+};
+
+/// An array that is being written by a JsonWriter, a small handle that can be passed by value.
+class JsonArrayWriter {
+ public:
+  template<typename T> void add(const T &value) {
+    if (this->writer_->begin_member_(this->depth_, this->generation_))
+      this->writer_->write_value_(value);
+  }
+  void add(const char *value) {
+    if (this->writer_->begin_member_(this->depth_, this->generation_))
+      this->writer_->write_value_(value);
+  }
+  JsonObjectWriter create_nested_object();
+  JsonArrayWriter create_nested_array();
+
+ protected:
+  friend JsonWriter;
+  friend JsonObjectWriter;
+  JsonArrayWriter(JsonWriter *writer, uint8_t depth)
+      : writer_(writer), depth_(depth), generation_(writer->generation_(depth)) {}
+
+  JsonWriter *writer_;
+  uint8_t depth_;
+  uint32_t generation_;
+};
+
+/// Write a JSON object with the provided write function, appending it to \p out.
+template<typename F> void write_json(std::string &out, F &&f) {
+  JsonWriter writer(out);
+  JsonObjectWriter root = writer.root();
+  f(root);
+}
+
+/// Write a JSON object with the provided write function into a new string.
+template<typename F> std::string write_json(F &&f) {
+  std::string out;
+  write_json(out, std::forward<F>(f));
+  return out;
+}
+
+}  // namespace json
+}  // namespace esphome
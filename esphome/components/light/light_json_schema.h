@@ -5,6 +5,7 @@
 #ifdef USE_JSON
 
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "light_call.h"
 #include "light_state.h"
 
@@ -14,7 +15,7 @@ namespace light {
 class LightJSONSchema {
  public:
   /// Dump the state of a light as JSON.
-  static void dump_json(LightState &state, JsonObject root);
+  static void dump_json(LightState &state, json::JsonObjectWriter root);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
 
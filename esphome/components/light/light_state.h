@@ -91,7 +91,9 @@ class LightState : public EntityBase, public Component {
    *
    * @param send_callback The callback.
    */
-  void add_new_remote_values_callback(std::function<void()> &&send_callback);
+  template<typename F> void add_new_remote_values_callback(F &&send_callback) {
+    this->remote_values_callback_.add(std::forward<F>(send_callback));
+  }
 
   /**
    * The callback is called once the state of current_values and remote_values are equal (when the
@@ -99,7 +101,9 @@ class LightState : public EntityBase, public Component {
    *
    * @param send_callback
    */
-  void add_new_target_state_reached_callback(std::function<void()> &&send_callback);
+  template<typename F> void add_new_target_state_reached_callback(F &&send_callback) {
+    this->target_state_reached_callback_.add(std::forward<F>(send_callback));
+  }
 
   /// Set the default transition length, i.e. the transition length when no transition is provided.
   void set_default_transition_length(uint32_t default_transition_length);
@@ -22,6 +22,7 @@ from esphome.const import (
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
     PLATFORM_RP2040,
+    PLATFORM_HOST,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
 from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
@@ -153,6 +154,17 @@ def validate_local_no_higher_than_global(value):
     return value
 
 
+def validate_serial_format(value):
+    if value[CONF_SERIAL_FORMAT] != SERIAL_FORMAT_BINARY:
+        return value
+    if value.get(CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH):
+        raise cv.Invalid(
+            f"{CONF_SERIAL_FORMAT}: {SERIAL_FORMAT_BINARY} needs the format strings in RAM, "
+            f"please set {CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH} to false"
+        )
+    return value
+
+
 Logger = logger_ns.class_("Logger", cg.Component)
 LoggerMessageTrigger = logger_ns.class_(
     "LoggerMessageTrigger",
@@ -160,6 +172,11 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_TASK_LOG_BUFFER_SIZE = "task_log_buffer_size"
+CONF_HISTORY_SIZE = "history_size"
+CONF_SERIAL_FORMAT = "serial_format"
+SERIAL_FORMAT_TEXT = "TEXT"
+SERIAL_FORMAT_BINARY = "BINARY"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -167,6 +184,24 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
+            cv.SplitDefault(
+                CONF_TASK_LOG_BUFFER_SIZE,
+                esp32=1024,
+                bk72xx=1024,
+                rtl87xx=1024,
+                host=4096,
+            ): cv.All(
+                cv.only_on(
+                    [PLATFORM_ESP32, PLATFORM_BK72XX, PLATFORM_RTL87XX, PLATFORM_HOST]
+                ),
+                cv.validate_bytes,
+                cv.int_range(max=32768),
+            ),
+            cv.Optional(CONF_HISTORY_SIZE): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_RP2040, PLATFORM_HOST]),
+                cv.validate_bytes,
+                cv.int_range(min=256, max=32768),
+            ),
             cv.SplitDefault(
                 CONF_HARDWARE_UART,
                 esp8266=UART0,
@@ -201,9 +236,13 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_SERIAL_FORMAT, default=SERIAL_FORMAT_TEXT): cv.one_of(
+                SERIAL_FORMAT_TEXT, SERIAL_FORMAT_BINARY, upper=True
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_serial_format,
 )
 
 
@@ -217,6 +256,12 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if task_log_buffer_size := config.get(CONF_TASK_LOG_BUFFER_SIZE):
+        cg.add_define("USE_LOGGER_TASK_LOG_BUFFER")
+        cg.add(log.create_task_log_buffer(task_log_buffer_size))
+    if history_size := config.get(CONF_HISTORY_SIZE):
+        cg.add_define("USE_LOGGER_HISTORY")
+        cg.add_define("USE_LOGGER_HISTORY_SIZE", history_size)
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -257,6 +302,8 @@ async def to_code(config):
         cg.add_build_flag("-DENABLE_I2C_DEBUG_BUFFER")
     if config.get(CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH):
         cg.add_build_flag("-DUSE_STORE_LOG_STR_IN_FLASH")
+    if config[CONF_SERIAL_FORMAT] == SERIAL_FORMAT_BINARY:
+        cg.add_define("USE_LOGGER_SERIAL_BINARY")
 
     if CORE.using_esp_idf:
         if config[CONF_HARDWARE_UART] == USB_CDC:
@@ -0,0 +1,220 @@
+#include "binary_log.h"
+
+#ifdef USE_LOGGER_SERIAL_BINARY
+
+#include <cstddef>
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+extern "C" const char esphome_log_format_anchor[] = "";  // NOLINT(readability-identifier-naming)
+
+namespace esphome {
+namespace logger {
+
+namespace {
+
+/// Appends to a fixed buffer; once a value didn't fit, nothing more is written so the record is never torn.
+class RecordWriter {
+ public:
+  RecordWriter(uint8_t *buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+  void varint(uint64_t value) {
+    uint8_t tmp[10];
+    size_t len = 0;
+    while (value > 0x7F) {
+      tmp[len++] = uint8_t(value & 0x7F) | 0x80;
+      value >>= 7;
+    }
+    tmp[len++] = uint8_t(value);
+    this->write_(tmp, len);
+  }
+  void zigzag(int64_t value) { this->varint((uint64_t(value) << 1) ^ uint64_t(value >> 63)); }
+  void float64(double value) { this->write_(&value, sizeof(value)); }
+  void string(const char *value) {
+    if (value == nullptr)
+      value = "(null)";
+    size_t len = strlen(value);
+    // truncate long strings rather than dropping them
+    if (!this->full_ && len + 2 > this->size_ - this->at_)
+      len = this->size_ - this->at_ > 2 ? this->size_ - this->at_ - 2 : 0;
+    this->varint(len);
+    this->write_(value, len);
+  }
+  size_t length() const { return this->at_; }
+
+ protected:
+  void write_(const void *data, size_t len) {
+    if (this->full_ || len > this->size_ - this->at_) {
+      this->full_ = true;
+      return;
+    }
+    memcpy(this->buffer_ + this->at_, data, len);
+    this->at_ += len;
+  }
+
+  uint8_t *buffer_;
+  size_t size_;
+  size_t at_{0};
+  bool full_{false};
+};
+
+enum LengthModifier : uint8_t {
+  LENGTH_DEFAULT,
+  LENGTH_LONG,
+  LENGTH_LONG_LONG,
+  LENGTH_INTMAX,
+  LENGTH_SIZE,
+  LENGTH_PTRDIFF,
+  LENGTH_LONG_DOUBLE,
+};
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+}  // namespace
+
+size_t HOT encode_binary_log_record(uint8_t *buffer, size_t size, int level, const char *tag, int line,
+                                    const char *format, va_list args) {
+  RecordWriter writer(buffer, size);
+  writer.varint(level);
+  writer.varint(line);
+  writer.zigzag(format - esphome_log_format_anchor);
+  writer.string(tag);
+
+  for (const char *p = format; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    p++;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    if (*p == '*') {
+      writer.zigzag(va_arg(args, int));
+      p++;
+    }
+    while (is_digit(*p))
+      p++;
+    if (*p == '.') {
+      p++;
+      if (*p == '*') {
+        writer.zigzag(va_arg(args, int));
+        p++;
+      }
+      while (is_digit(*p))
+        p++;
+    }
+
+    LengthModifier length = LENGTH_DEFAULT;
+    switch (*p) {
+      case 'h':
+        // char and short arguments are promoted to int
+        p += p[1] == 'h' ? 2 : 1;
+        break;
+      case 'l':
+        length = p[1] == 'l' ? LENGTH_LONG_LONG : LENGTH_LONG;
+        p += p[1] == 'l' ? 2 : 1;
+        break;
+      case 'j':
+        length = LENGTH_INTMAX;
+        p++;
+        break;
+      case 'z':
+        length = LENGTH_SIZE;
+        p++;
+        break;
+      case 't':
+        length = LENGTH_PTRDIFF;
+        p++;
+        break;
+      case 'L':
+        length = LENGTH_LONG_DOUBLE;
+        p++;
+        break;
+      default:
+        break;
+    }
+
+    switch (*p) {
+      case 'd':
+      case 'i':
+        switch (length) {
+          case LENGTH_LONG:
+            writer.zigzag(va_arg(args, long));
+            break;
+          case LENGTH_LONG_LONG:
+            writer.zigzag(va_arg(args, long long));
+            break;
+          case LENGTH_INTMAX:
+            writer.zigzag(va_arg(args, intmax_t));
+            break;
+          case LENGTH_SIZE:
+          case LENGTH_PTRDIFF:
+            writer.zigzag(va_arg(args, ptrdiff_t));
+            break;
+          default:
+            writer.zigzag(va_arg(args, int));
+            break;
+        }
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        switch (length) {
+          case LENGTH_LONG:
+            writer.varint(va_arg(args, unsigned long));
+            break;
+          case LENGTH_LONG_LONG:
+            writer.varint(va_arg(args, unsigned long long));
+            break;
+          case LENGTH_INTMAX:
+            writer.varint(va_arg(args, uintmax_t));
+            break;
+          case LENGTH_SIZE:
+          case LENGTH_PTRDIFF:
+            writer.varint(va_arg(args, size_t));
+            break;
+          default:
+            writer.varint(va_arg(args, unsigned int));
+            break;
+        }
+        break;
+      case 'c':
+        writer.varint(uint8_t(va_arg(args, int)));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        if (length == LENGTH_LONG_DOUBLE) {
+          writer.float64(double(va_arg(args, long double)));
+        } else {
+          writer.float64(va_arg(args, double));
+        }
+        break;
+      case 's':
+        writer.string(va_arg(args, const char *));
+        break;
+      case 'p':
+        writer.varint(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 'n':
+        va_arg(args, void *);
+        break;
+      case '%':
+        break;
+      default:
+        // unknown conversion (or end of the format string), the size of any further arguments is unknown
+        return writer.length();
+    }
+  }
+  return writer.length();
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_SERIAL_BINARY
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_SERIAL_BINARY
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+/// Format strings are referenced by their distance to this symbol, so records stay valid for relocated binaries.
+extern "C" const char esphome_log_format_anchor[];  // NOLINT(readability-identifier-naming)
+
+namespace esphome {
+namespace logger {
+
+/// First byte of a serial log line that holds a base64 encoded binary record instead of text.
+static const char BINARY_LOG_RECORD_MARKER = '\x02';
+
+/** Encode a log message as a compact binary record, without formatting it.
+ *
+ * The record holds the level, line, tag and the position of the format string in the firmware, followed by the raw
+ * arguments in the order the format string consumes them (varints for integers, little endian doubles, length
+ * prefixed strings). `esphome logs` looks the format string up in the firmware ELF and formats the message on the
+ * host. Arguments that don't fit into `size` are left out.
+ *
+ * The format must be a string literal. A format built at runtime is not in the ELF and shows up as an unknown
+ * format string, so such messages have to be formatted first and logged with "%s".
+ *
+ * @return The length of the record.
+ */
+size_t encode_binary_log_record(uint8_t *buffer, size_t size, int level, const char *tag, int line,
+                                const char *format, va_list args);
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_SERIAL_BINARY
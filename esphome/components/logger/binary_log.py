@@ -0,0 +1,210 @@
+"""Decoder for the binary log records written with `serial_format: BINARY`.
+
+A record line starts with RECORD_MARKER, followed by the base64 encoded record
+(see encode_binary_log_record() in binary_log.h). The format strings are not
+part of the record, they are read from the firmware ELF file instead.
+"""
+from __future__ import annotations
+
+import base64
+import binascii
+import re
+import struct
+
+RECORD_MARKER = "\x02"
+ANCHOR_SYMBOL = "esphome_log_format_anchor"
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+LOG_LEVEL_COLORS = [
+    "",  # NONE
+    "\033[1;31m",  # ERROR
+    "\033[0;33m",  # WARNING
+    "\033[0;32m",  # INFO
+    "\033[0;35m",  # CONFIG
+    "\033[0;36m",  # DEBUG
+    "\033[0;37m",  # VERBOSE
+    "\033[0;38m",  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+RESET_COLOR = "\033[0m"
+
+# printf conversion: flags, width, precision, length modifier, conversion
+CONVERSION_RE = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diouxXcfFeEgGaAspn%])"
+)
+
+
+class FirmwareStrings:
+    """Looks up null terminated strings in the allocated sections of an ELF file."""
+
+    def __init__(self, path: str) -> None:
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        is_64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+
+        if is_64:
+            shoff, shentsize, shnum = (
+                struct.unpack_from(f"{endian}Q", data, 0x28)[0],
+                *struct.unpack_from(f"{endian}HH", data, 0x3A),
+            )
+            section_format = f"{endian}IIQQQQIIQQ"
+            symbol_format, symbol_size = f"{endian}IBBHQQ", 24
+        else:
+            shoff, shentsize, shnum = (
+                struct.unpack_from(f"{endian}I", data, 0x20)[0],
+                *struct.unpack_from(f"{endian}HH", data, 0x2E),
+            )
+            section_format = f"{endian}IIIIIIIIII"
+            symbol_format, symbol_size = f"{endian}IIIBBH", 16
+
+        sections = [
+            struct.unpack_from(section_format, data, shoff + i * shentsize)
+            for i in range(shnum)
+        ]
+        # (address, contents) of every section that is loaded to the device
+        self._sections: list[tuple[int, bytes]] = []
+        self.anchor: int | None = None
+        for _, sh_type, flags, addr, offset, size, link, *_ in sections:
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and addr != 0:
+                self._sections.append((addr, data[offset : offset + size]))
+            if sh_type == SHT_SYMTAB:
+                strtab_offset = sections[link][4]
+                for pos in range(offset, offset + size, symbol_size):
+                    symbol = struct.unpack_from(symbol_format, data, pos)
+                    name_offset = symbol[0]
+                    value = symbol[4] if is_64 else symbol[1]
+                    start = strtab_offset + name_offset
+                    name = data[start : data.index(b"\0", start)]
+                    if name == ANCHOR_SYMBOL.encode():
+                        self.anchor = value
+        if self.anchor is None:
+            raise ValueError(f"{path} was not built with binary logging")
+
+    def string_at(self, address: int) -> str | None:
+        for start, contents in self._sections:
+            if start <= address < start + len(contents):
+                offset = address - start
+                end = contents.find(b"\0", offset)
+                if end == -1:
+                    return None
+                return contents[offset:end].decode("utf8", "backslashreplace")
+        return None
+
+
+class _Reader:
+    def __init__(self, data: bytes) -> None:
+        self.data = data
+        self.pos = 0
+
+    def varint(self) -> int:
+        result = shift = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise EOFError
+            byte = self.data[self.pos]
+            self.pos += 1
+            result |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return result
+
+    def zigzag(self) -> int:
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def float64(self) -> float:
+        if self.pos + 8 > len(self.data):
+            raise EOFError
+        (value,) = struct.unpack_from("<d", self.data, self.pos)
+        self.pos += 8
+        return value
+
+    def string(self) -> str:
+        length = self.varint()
+        if self.pos + length > len(self.data):
+            raise EOFError
+        value = self.data[self.pos : self.pos + length]
+        self.pos += length
+        return value.decode("utf8", "backslashreplace")
+
+
+def _format_message(fmt: str, reader: _Reader) -> str:
+    """printf() with the arguments taken from the record."""
+
+    def convert(match: re.Match) -> str:
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = str(reader.zigzag())
+        if precision == "*":
+            precision = str(reader.zigzag())
+        spec = "%" + flags + (width or "")
+        if precision is not None:
+            spec += "." + precision
+        if conversion in "di":
+            return (spec + "d") % reader.zigzag()
+        if conversion == "o" and "#" in flags:
+            # C prefixes octal numbers with "0", Python with "0o"
+            digits = "%o" % reader.varint()
+            if not digits.startswith("0"):
+                digits = "0" + digits
+            flags = flags.replace("#", "").replace("0", "")
+            return ("%" + flags + (width or "") + "s") % digits
+        if conversion in "uoxX":
+            return (spec + ("d" if conversion == "u" else conversion)) % reader.varint()
+        if conversion == "c":
+            return (spec + "c") % chr(reader.varint())
+        if conversion in "fFeEgG":
+            return (spec + conversion) % reader.float64()
+        if conversion in "aA":
+            return reader.float64().hex()
+        if conversion == "s":
+            return (spec + "s") % reader.string()
+        if conversion == "p":
+            return f"0x{reader.varint():x}"
+        return ""
+
+    parts = []
+    last = 0
+    for match in CONVERSION_RE.finditer(fmt):
+        parts.append(fmt[last : match.start()])
+        try:
+            parts.append(convert(match))
+        except EOFError:
+            # the device truncated the record
+            parts.append("...")
+            return "".join(parts)
+        last = match.end()
+    parts.append(fmt[last:])
+    return "".join(parts)
+
+
+def decode_record_line(line: str, strings: FirmwareStrings) -> str | None:
+    """Turn a record line into the text the device would have logged, None if it isn't one."""
+    if not line.startswith(RECORD_MARKER):
+        return None
+    try:
+        reader = _Reader(base64.b64decode(line[len(RECORD_MARKER) :]))
+        level = min(reader.varint(), len(LOG_LEVEL_LETTERS) - 1)
+        line_number = reader.varint()
+        fmt_address = strings.anchor + reader.zigzag()
+        tag = reader.string()
+    except (binascii.Error, EOFError):
+        return f"<invalid binary log record {line[len(RECORD_MARKER):]}>"
+
+    fmt = strings.string_at(fmt_address)
+    if fmt is None:
+        message = f"<unknown format string at 0x{fmt_address:x}>"
+    else:
+        message = _format_message(fmt, reader).rstrip("\n")
+    return (
+        f"{LOG_LEVEL_COLORS[level]}[{LOG_LEVEL_LETTERS[level]}][{tag}:{line_number:03}]: "
+        f"{message}{RESET_COLOR}"
+    )
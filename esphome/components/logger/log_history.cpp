@@ -0,0 +1,128 @@
+#include "log_history.h"
+
+#ifdef USE_LOGGER_HISTORY
+
+#include "esphome/core/helpers.h"
+
+#if defined(USE_ESP32)
+#include <esp_attr.h>
+#elif defined(USE_RP2040)
+#include <pico.h>
+#elif defined(USE_HOST)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "esphome/core/application.h"
+#endif
+
+namespace esphome {
+namespace logger {
+
+static const uint32_t LOG_HISTORY_MAGIC = 0x4C4F4748;  // "LOGH"
+
+struct LogHistoryStorage {
+  /// LOG_HISTORY_MAGIC if the rest of the storage was written by a previous boot, anything else after a power cycle.
+  uint32_t magic;
+  /// Position in `data` the next character is written to.
+  uint32_t head;
+  /// Non-zero once `data` wrapped around, i.e. all of it holds history.
+  uint32_t wrapped;
+  char data[USE_LOGGER_HISTORY_SIZE];
+};
+
+#if defined(USE_ESP32)
+static __NOINIT_ATTR LogHistoryStorage log_history_storage;  // NOLINT
+static LogHistoryStorage *get_storage() { return &log_history_storage; }
+#elif defined(USE_RP2040)
+static LogHistoryStorage __uninitialized_ram(log_history_storage);  // NOLINT
+static LogHistoryStorage *get_storage() { return &log_history_storage; }
+#elif defined(USE_HOST)
+static LogHistoryStorage *get_storage() {
+  // a file mapping keeps the history when the process crashes or is killed
+  const std::string path = App.get_name() + ".log_history";
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return nullptr;
+  void *mem = MAP_FAILED;
+  if (ftruncate(fd, sizeof(LogHistoryStorage)) == 0)
+    mem = mmap(nullptr, sizeof(LogHistoryStorage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  return mem == MAP_FAILED ? nullptr : static_cast<LogHistoryStorage *>(mem);
+}
+#endif
+
+static std::string read_storage(const LogHistoryStorage *storage) {
+  std::string result;
+  const uint32_t head = storage->head;
+  if (storage->wrapped) {
+    result.reserve(sizeof(storage->data));
+    result.append(storage->data + head, sizeof(storage->data) - head);
+  }
+  result.append(storage->data, head);
+  if (storage->wrapped) {
+    // the oldest line was partly overwritten
+    const size_t start = result.find('\n');
+    result.erase(0, start == std::string::npos ? result.size() : start + 1);
+  }
+  return result;
+}
+
+void LogHistory::init() {
+  this->storage_ = get_storage();
+  if (this->storage_ == nullptr)
+    return;
+  LogHistoryStorage *storage = this->storage_;
+  if (storage->magic == LOG_HISTORY_MAGIC && storage->head < sizeof(storage->data) && storage->wrapped <= 1)
+    this->previous_ = read_storage(storage);
+  storage->head = 0;
+  storage->wrapped = 0;
+  storage->magic = LOG_HISTORY_MAGIC;
+}
+
+void HOT LogHistory::append(const char *msg) {
+  if (this->storage_ == nullptr)
+    return;
+  LogHistoryStorage *storage = this->storage_;
+  uint32_t head = storage->head;
+  auto put = [storage, &head](char c) {
+    storage->data[head++] = c;
+    if (head == sizeof(storage->data)) {
+      head = 0;
+      storage->wrapped = 1;
+    }
+  };
+  for (const char *p = msg; *p != '\0'; p++) {
+    if (*p == '\033') {
+      // skip color codes like "\033[0;36m"
+      while (p[1] != '\0' && *p != 'm')
+        p++;
+      continue;
+    }
+    put(*p);
+  }
+  put('\n');
+  // only publish the new head once the line is complete
+  storage->head = head;
+}
+
+std::string LogHistory::get_previous() {
+  LockGuard guard{this->previous_lock_};
+  return this->previous_;
+}
+
+void LogHistory::clear_previous() {
+  LockGuard guard{this->previous_lock_};
+  this->previous_.clear();
+  this->previous_.shrink_to_fit();
+}
+
+std::string LogHistory::get_current() const {
+  if (this->storage_ == nullptr)
+    return {};
+  return read_storage(this->storage_);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_HISTORY
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_HISTORY
+
+#include <cstdint>
+#include <string>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace logger {
+
+struct LogHistoryStorage;
+
+/** Circular buffer of the most recent log lines that survives soft resets.
+ *
+ * The buffer lives in memory that the startup code doesn't clear (noinit RAM on the ESP32 and RP2040, a memory-mapped
+ * file on host), so after a watchdog reset, panic or restart the lines that led up to it can still be read. A power
+ * cycle loses them.
+ */
+class LogHistory {
+ public:
+  /// Take over the lines the previous boot left in the buffer, then start the history of this boot.
+  void init();
+  /// Append a log message as one line, without its color codes.
+  void append(const char *msg);
+
+  /// The lines logged by the previous boot, oldest first. Empty if there are none, e.g. after a power cycle, or once
+  /// they were cleared.
+  std::string get_previous();
+  /** Free the lines of the previous boot.
+   *
+   * The buffer is reused by this boot, so the previous boot's lines are copied in init() and held for the whole
+   * uptime. A client that stored them can release that memory with this.
+   */
+  void clear_previous();
+  /// Size of the previous boot's lines, 0 once they were cleared.
+  size_t get_previous_size() const { return this->previous_.size(); }
+  /// The lines logged by this boot that are still in the buffer, oldest first. When called from another task than
+  /// the main loop, the newest line may be incomplete.
+  std::string get_current() const;
+
+  /// Set by the debug component, describes what ended the previous boot.
+  void set_reset_reason(const std::string &reset_reason) { this->reset_reason_ = reset_reason; }
+  const std::string &get_reset_reason() const { return this->reset_reason_; }
+
+ protected:
+  LogHistoryStorage *storage_{nullptr};
+  std::string previous_;
+  /// The previous boot's lines may be read and cleared from the web server task.
+  Mutex previous_lock_;
+  std::string reset_reason_;
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_HISTORY
@@ -1,5 +1,7 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 #ifdef USE_ESP_IDF
 #include <driver/uart.h>
@@ -52,22 +54,53 @@ static const char *const LOG_LEVEL_LETTERS[] = {
     "VV",  // VERY_VERBOSE
 };
 
-void Logger::write_header_(int level, const char *tag, int line) {
+static const char *const LOG_HEADER_FORMAT = "%s[%s][%s:%03u]: ";
+
+static int clamp_log_level(int level) {
   if (level < 0)
-    level = 0;
+    return 0;
   if (level > 7)
-    level = 7;
+    return 7;
+  return level;
+}
 
+void Logger::write_header_(int level, const char *tag, int line) {
+  level = clamp_log_level(level);
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
-  this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
+  this->printf_to_buffer_(LOG_HEADER_FORMAT, color, letter, tag, line);
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->task_log_buffer_ != nullptr && !this->is_main_task_()) {
+    this->log_to_task_buffer_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  // messages other tasks logged before this one come first
+  this->process_task_log_buffer_();
+#endif
+#ifdef USE_LOGGER_SERIAL_BINARY
+  va_list args_copy;
+  va_copy(args_copy, args);
+  this->write_binary_record_(level, tag, line, format, args_copy);
+  va_end(args_copy);
+#ifndef USE_LOGGER_HISTORY
+  if (this->log_callback_.size() == 0) {
+    // nobody needs the formatted text
+    recursion_guard_ = false;
+    return;
+  }
+#endif
+#endif
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -158,16 +191,36 @@ void Logger::init_usb_serial_jtag_() {
 #endif
 #endif
 
+static size_t tag_level_cache_index(const char *tag, size_t size) {
+  const auto address = reinterpret_cast<uintptr_t>(tag);
+  return ((address >> 2) ^ (address >> 8)) & (size - 1);
+}
+
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
+  if (this->tag_level_cache_ == nullptr)
+    return ESPHOME_LOG_LEVEL;
+  TagLevelCacheEntry &entry = this->tag_level_cache_[tag_level_cache_index(tag, TAG_LEVEL_CACHE_SIZE)];
+  const char *cached = entry.tag.load(std::memory_order_acquire);
+  if (cached == tag)
+    return entry.level;
+
+  int level = ESPHOME_LOG_LEVEL;
   for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
-      return it.level;
+    if (strcmp(it.tag.c_str(), tag) == 0) {
+      level = it.level;
+      break;
     }
   }
-  return ESPHOME_LOG_LEVEL;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  // two tasks must not claim the same entry at once
+  if (!this->is_main_task_())
+    return level;
+#endif
+  if (cached == nullptr) {
+    entry.level = level;
+    entry.tag.store(tag, std::memory_order_release);
+  }
+  return level;
 }
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // remove trailing newline
@@ -178,6 +231,23 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->set_null_terminator_();
 
   const char *msg = this->tx_buffer_ + offset;
+#ifdef USE_LOGGER_HISTORY
+  this->history_.append(msg);
+#endif
+#ifndef USE_LOGGER_SERIAL_BINARY
+  // in binary mode, the serial port got the message as a record already
+  this->write_serial_(msg);
+#endif
+  this->call_log_callbacks_(level, tag, msg);
+}
+void HOT Logger::write_message_(int level, const char *tag, const char *msg) {
+#ifdef USE_LOGGER_HISTORY
+  this->history_.append(msg);
+#endif
+  this->write_serial_(msg);
+  this->call_log_callbacks_(level, tag, msg);
+}
+void HOT Logger::write_serial_(const char *msg) {
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     this->hw_serial_->println(msg);
@@ -201,7 +271,11 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
     }
 #endif
   }
-
+#ifdef USE_HOST
+  puts(msg);
+#endif
+}
+void HOT Logger::call_log_callbacks_(int level, const char *tag, const char *msg) {
 #ifdef USE_ESP32
   // Suppress network-logging if memory constrained, but still log to serial
   // ports. In some configurations (eg BLE enabled) there may be some transient
@@ -211,9 +285,6 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   if (xPortGetFreeHeapSize() < 2048)
     return;
 #endif
-#ifdef USE_HOST
-  puts(msg);
-#endif
 
   this->log_callback_.call(level, tag, msg);
 }
@@ -221,8 +292,122 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
+#ifdef USE_LOGGER_SERIAL_BINARY
+  // the base64 encoded record and its marker must fit into the tx buffer
+  this->record_buffer_size_ = (this->tx_buffer_size_ - 1) / 4 * 3;
+  this->record_buffer_ = new uint8_t[this->record_buffer_size_];  // NOLINT
+#endif
 }
 
+#ifdef USE_LOGGER_SERIAL_BINARY
+static const char *const BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void HOT Logger::write_binary_record_(int level, const char *tag, int line, const char *format, va_list args) {
+  if (this->baud_rate_ == 0)
+    return;
+  const size_t len =
+      encode_binary_log_record(this->record_buffer_, this->record_buffer_size_, level, tag, line, format, args);
+
+  char *out = this->tx_buffer_;
+  *out++ = BINARY_LOG_RECORD_MARKER;
+  for (size_t i = 0; i < len; i += 3) {
+    const uint32_t chunk = (uint32_t(this->record_buffer_[i]) << 16) |
+                           (i + 1 < len ? uint32_t(this->record_buffer_[i + 1]) << 8 : 0) |
+                           (i + 2 < len ? uint32_t(this->record_buffer_[i + 2]) : 0);
+    *out++ = BASE64_CHARS[(chunk >> 18) & 0x3F];
+    *out++ = BASE64_CHARS[(chunk >> 12) & 0x3F];
+    *out++ = i + 1 < len ? BASE64_CHARS[(chunk >> 6) & 0x3F] : '=';
+    *out++ = i + 2 < len ? BASE64_CHARS[chunk & 0x3F] : '=';
+  }
+  *out = '\0';
+  this->write_serial_(this->tx_buffer_);
+}
+#endif
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+void Logger::create_task_log_buffer(size_t size) { this->task_log_buffer_ = make_unique<TaskLogBuffer>(size); }
+
+bool HOT Logger::is_main_task_() const {
+#if defined(USE_ESP32)
+  return !xPortInIsrContext() && xTaskGetCurrentTaskHandle() == this->main_task_;
+#elif defined(USE_LIBRETINY)
+  return xTaskGetCurrentTaskHandle() == this->main_task_;
+#elif defined(USE_HOST)
+  return std::this_thread::get_id() == this->main_task_;
+#else
+  return true;
+#endif
+}
+
+void HOT Logger::log_to_task_buffer_(int level, const char *tag, int line, const char *format, va_list args) {
+  const int clamped = clamp_log_level(level);
+  const char *color = LOG_LEVEL_COLORS[clamped];
+  const char *letter = LOG_LEVEL_LETTERS[clamped];
+  const size_t footer_len = strlen(ESPHOME_LOG_RESET_COLOR);
+
+  // measure first so that the message takes no more room in the buffer than it needs
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const int header_len = snprintf(nullptr, 0, LOG_HEADER_FORMAT, color, letter, tag, line);
+  const int format_len = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (header_len < 0 || format_len < 0)
+    return;
+  const size_t length = std::min<size_t>(header_len + format_len + footer_len, this->tx_buffer_size_);
+
+  char *msg = this->task_log_buffer_->acquire(length);
+  if (msg == nullptr) {
+    // full, make sure the main loop drains it
+    this->enable_loop_soon_any_context();
+    return;
+  }
+  size_t at = std::min<size_t>(snprintf(msg, length + 1, LOG_HEADER_FORMAT, color, letter, tag, line), length);
+  const int ret = vsnprintf(msg + at, length + 1 - at, format, args);
+  if (ret > 0)
+    at = std::min<size_t>(at + ret, length);
+  // remove trailing newline
+  if (at > 0 && msg[at - 1] == '\n')
+    at--;
+  const size_t footer = std::min(footer_len, length - at);
+  memcpy(msg + at, ESPHOME_LOG_RESET_COLOR, footer);
+  this->task_log_buffer_->commit(msg, level, tag, at + footer);
+  this->enable_loop_soon_any_context();
+}
+
+void Logger::process_task_log_buffer_() {
+  if (this->task_log_buffer_ == nullptr)
+    return;
+  const uint32_t dropped = this->task_log_buffer_->take_dropped();
+  if (dropped != 0) {
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("Task log buffer full, dropped %" PRIu32 " messages from other tasks", dropped);
+    this->write_footer_();
+    this->set_null_terminator_();
+    this->write_message_(ESPHOME_LOG_LEVEL_WARN, TAG, this->tx_buffer_);
+  }
+
+  uint8_t level;
+  const char *tag;
+  uint16_t length;
+  const char *msg;
+  while ((msg = this->task_log_buffer_->front(&level, &tag, &length)) != nullptr) {
+    this->write_message_(level, tag, msg);
+    this->task_log_buffer_->pop();
+  }
+}
+
+void Logger::loop() {
+  if (!this->recursion_guard_) {
+    this->recursion_guard_ = true;
+    this->process_task_log_buffer_();
+    this->recursion_guard_ = false;
+  }
+  // woken up again by the next message from another task
+  this->disable_loop();
+}
+#endif
+
 #ifndef USE_LIBRETINY
 void Logger::pre_setup() {
   if (this->baud_rate_ > 0) {
@@ -315,6 +500,16 @@ void Logger::pre_setup() {
   }
 #endif  // USE_ESP8266
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#elif defined(USE_HOST)
+  this->main_task_ = std::this_thread::get_id();
+#endif
+#endif
+#ifdef USE_LOGGER_HISTORY
+  this->history_.init();
+#endif
   global_logger = this;
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
@@ -366,6 +561,13 @@ void Logger::pre_setup() {
     }
   }
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#elif defined(USE_HOST)
+  this->main_task_ = std::this_thread::get_id();
+#endif
+#endif
   global_logger = this;
   ESP_LOGI(TAG, "Log initialized");
 }
@@ -373,7 +575,22 @@ void Logger::pre_setup() {
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  if (this->tag_level_cache_ == nullptr)
+    this->tag_level_cache_.reset(new TagLevelCacheEntry[TAG_LEVEL_CACHE_SIZE]);  // NOLINT(modernize-avoid-c-arrays)
+
+  auto it = std::find_if(this->log_levels_.begin(), this->log_levels_.end(),
+                         [&tag](const LogLevelOverride &o) { return o.tag == tag; });
+  if (it != this->log_levels_.end()) {
+    it->level = log_level;
+  } else {
+    this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  }
+  for (uint8_t i = 0; i < TAG_LEVEL_CACHE_SIZE; i++) {
+    TagLevelCacheEntry &entry = this->tag_level_cache_[i];
+    const char *cached = entry.tag.load(std::memory_order_acquire);
+    if (cached != nullptr && tag == cached)
+      entry.level = log_level;
+  }
 }
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
@@ -416,6 +633,18 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
+#ifdef USE_LOGGER_SERIAL_BINARY
+  ESP_LOGCONFIG(TAG, "  Serial Format: BINARY");
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->task_log_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Task Log Buffer Size: %u", (unsigned) this->task_log_buffer_->get_capacity());
+  }
+#endif
+#ifdef USE_LOGGER_HISTORY
+  ESP_LOGCONFIG(TAG, "  History Size: %u", (unsigned) USE_LOGGER_HISTORY_SIZE);
+  ESP_LOGCONFIG(TAG, "  Previous Boot History: %u bytes", (unsigned) this->history_.get_previous_size());
+#endif
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
 #endif
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <cstdarg>
+#include <memory>
 #include <vector>
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "binary_log.h"
+#include "log_history.h"
+#include "task_log_buffer.h"
 
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
@@ -21,6 +26,18 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#if defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(USE_LIBRETINY)
+#include <FreeRTOS.h>
+#include <task.h>
+#elif defined(USE_HOST)
+#include <thread>
+#endif
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
+
 namespace esphome {
 
 namespace logger {
@@ -85,15 +102,37 @@ class Logger : public Component {
   UARTSelection get_uart() const;
 #endif
 
-  /// Set the log level of the specified tag.
+  /// Set the log level of the specified tag, can also be called at runtime to change it.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  /** Queue messages logged outside of the main loop task in a buffer of the given size.
+   *
+   * Messages from other tasks (e.g. Wi-Fi, BLE or ESP-IDF log output) are then only formatted on the calling task
+   * and written to the UART and log callbacks from the main loop, so they never race with the main loop's messages
+   * and never block on a slow subscriber. Messages that don't fit are dropped and counted.
+   */
+  void create_task_log_buffer(size_t size);
+#endif
+#ifdef USE_LOGGER_HISTORY
+  /// The log lines of this and the previous boot, kept in memory that survives soft resets.
+  LogHistory &get_history() { return this->history_; }
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
   void pre_setup();
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  void loop() override;
+#endif
   void dump_config() override;
 
+  /** The maximum level logged for a tag.
+   *
+   * Tags are expected to be string constants (like every component's `TAG`): the result is cached by the tag's
+   * address, so repeated lookups are a single array access instead of comparing the tag to every override.
+   */
   int level_for(const char *tag);
 
   /// Register a callback that will be called for every log message sent
@@ -120,6 +159,21 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  /// Write a finished message to the UART and the log callbacks.
+  void write_message_(int level, const char *tag, const char *msg);
+  void write_serial_(const char *msg);
+  void call_log_callbacks_(int level, const char *tag, const char *msg);
+#ifdef USE_LOGGER_SERIAL_BINARY
+  /// Write the message as a base64 encoded binary record to the UART, see encode_binary_log_record().
+  void write_binary_record_(int level, const char *tag, int line, const char *format, va_list args);
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  bool is_main_task_() const;
+  /// Format a message into the task log buffer, for tasks other than the main loop task.
+  void log_to_task_buffer_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Write all queued messages of other tasks. Must only be called from the main loop task.
+  void process_task_log_buffer_();
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -163,6 +217,10 @@ class Logger : public Component {
   char *tx_buffer_{nullptr};
   int tx_buffer_at_{0};
   int tx_buffer_size_{0};
+#ifdef USE_LOGGER_SERIAL_BINARY
+  uint8_t *record_buffer_{nullptr};
+  size_t record_buffer_size_{0};
+#endif
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040)
   UARTSelection uart_{UART_SELECTION_UART0};
 #endif
@@ -180,9 +238,29 @@ class Logger : public Component {
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  /// Direct-mapped cache of level_for() results. Entries are filled once and never evicted, so other tasks can read
+  /// them without locking; set_log_level() only updates the level of the matching entries.
+  struct TagLevelCacheEntry {
+    std::atomic<const char *> tag{nullptr};
+    uint8_t level;
+  };
+  static const uint8_t TAG_LEVEL_CACHE_SIZE = 32;
+  /// Only allocated once there are overrides, without any every tag has the global level.
+  std::unique_ptr<TagLevelCacheEntry[]> tag_level_cache_;  // NOLINT(modernize-avoid-c-arrays)
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_HISTORY
+  LogHistory history_;
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  std::unique_ptr<TaskLogBuffer> task_log_buffer_;
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  TaskHandle_t main_task_{nullptr};
+#elif defined(USE_HOST)
+  std::thread::id main_task_;
+#endif
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
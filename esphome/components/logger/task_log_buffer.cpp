@@ -0,0 +1,92 @@
+#include "task_log_buffer.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+static const uint32_t ENTRY_ALIGN = 8;
+static_assert(ENTRY_ALIGN >= alignof(void *), "log entries must be aligned for their header");
+
+TaskLogBuffer::TaskLogBuffer(size_t capacity) {
+  this->capacity_ = 1 << (32 - __builtin_clz(std::max<uint32_t>(capacity, 2 * ENTRY_ALIGN) - 1));
+  this->mask_ = this->capacity_ - 1;
+  this->data_.reset(new uint8_t[this->capacity_]());  // NOLINT(modernize-avoid-c-arrays)
+}
+
+char *TaskLogBuffer::acquire(size_t length) {
+  const uint32_t size = (sizeof(Entry) + length + 1 + ENTRY_ALIGN - 1) & ~(ENTRY_ALIGN - 1);
+  uint32_t head = this->head_.load(std::memory_order_relaxed);
+  uint32_t pad;
+  do {
+    // an entry never wraps around, skip the rest of the ring if it doesn't fit there
+    const uint32_t to_end = this->capacity_ - (head & this->mask_);
+    pad = to_end < size ? to_end : 0;
+    if (head + pad + size - this->tail_.load(std::memory_order_acquire) > this->capacity_) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+  } while (!this->head_.compare_exchange_weak(head, head + pad + size, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+
+  if (pad >= sizeof(Entry)) {
+    // smaller gaps are skipped by the consumer without a header
+    Entry *padding = this->entry_at_(head);
+    padding->size = pad;
+    padding->state.store(ENTRY_PADDING, std::memory_order_release);
+  }
+  Entry *entry = this->entry_at_(head + pad);
+  entry->size = size;
+  return reinterpret_cast<char *>(entry + 1);
+}
+
+void TaskLogBuffer::commit(char *message, uint8_t level, const char *tag, uint16_t length) {
+  Entry *entry = reinterpret_cast<Entry *>(message) - 1;
+  entry->tag = tag;
+  entry->level = level;
+  entry->length = length;
+  message[length] = '\0';
+  entry->state.store(ENTRY_COMMITTED, std::memory_order_release);
+}
+
+const char *TaskLogBuffer::front(uint8_t *level, const char **tag, uint16_t *length) {
+  while (true) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return nullptr;
+    const uint32_t to_end = this->capacity_ - (tail & this->mask_);
+    if (to_end < sizeof(Entry)) {
+      this->release_(to_end);
+      continue;
+    }
+    Entry *entry = this->entry_at_(tail);
+    const uint8_t state = entry->state.load(std::memory_order_acquire);
+    if (state == ENTRY_WRITING)
+      return nullptr;
+    if (state == ENTRY_PADDING) {
+      this->release_(entry->size);
+      continue;
+    }
+    *level = entry->level;
+    *tag = entry->tag;
+    *length = entry->length;
+    return reinterpret_cast<const char *>(entry + 1);
+  }
+}
+
+void TaskLogBuffer::pop() { this->release_(this->entry_at_(this->tail_.load(std::memory_order_relaxed))->size); }
+
+void TaskLogBuffer::release_(uint32_t size) {
+  const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  // producers rely on free room being zeroed, see ENTRY_WRITING
+  memset(&this->data_[tail & this->mask_], 0, size);
+  this->tail_.store(tail + size, std::memory_order_release);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Multi-producer, single-consumer ring buffer of formatted log messages.
+ *
+ * Any task can acquire() room for a message with a lock-free compare-and-swap, write the message and commit() it.
+ * The single consumer (the main loop) takes committed messages with front()/pop() in the order their room was
+ * acquired; a message that is still being written holds back the ones after it until it is committed.
+ *
+ * Messages that don't fit are dropped and counted instead of blocking the producer.
+ */
+class TaskLogBuffer {
+ public:
+  /// `capacity` is rounded up to a power of two.
+  explicit TaskLogBuffer(size_t capacity);
+
+  /// Reserve room for a message of up to `length` characters plus null terminator. nullptr if the buffer is full.
+  char *acquire(size_t length);
+  /// Publish a message written to the room returned by acquire(). `length` must not exceed the acquired length.
+  void commit(char *message, uint8_t level, const char *tag, uint16_t length);
+
+  /// The oldest committed message (null terminated), or nullptr if there is none. Must only be called by the consumer.
+  const char *front(uint8_t *level, const char **tag, uint16_t *length);
+  /// Free the message returned by front(). Must only be called by the consumer.
+  void pop();
+
+  /// Number of messages dropped since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+  size_t get_capacity() const { return this->capacity_; }
+
+ protected:
+  enum EntryState : uint8_t {
+    // Must be zero: room that is not (or no longer) used is zeroed, so a fresh entry reads as being written.
+    ENTRY_WRITING = 0,
+    ENTRY_COMMITTED = 1,
+    // Skipped space at the end of the ring, the following entry starts at the beginning.
+    ENTRY_PADDING = 2,
+  };
+
+  struct Entry {
+    const char *tag;
+    /// Size in bytes of the whole entry, including this header and alignment.
+    uint32_t size;
+    uint16_t length;
+    uint8_t level;
+    std::atomic<uint8_t> state;
+  };
+
+  Entry *entry_at_(uint32_t position) { return reinterpret_cast<Entry *>(&this->data_[position & this->mask_]); }
+  void release_(uint32_t size);
+
+  std::unique_ptr<uint8_t[]> data_;  // NOLINT(modernize-avoid-c-arrays)
+  uint32_t capacity_;
+  uint32_t mask_;
+  /// Free-running byte counters, only their low bits (`& mask_`) are positions in `data_`.
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
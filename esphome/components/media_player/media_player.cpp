@@ -108,10 +108,6 @@ MediaPlayerCall &MediaPlayerCall::set_volume(float volume) {
   return *this;
 }
 
-void MediaPlayer::add_on_state_callback(std::function<void()> &&callback) {
-  this->state_callback_.add(std::move(callback));
-}
-
 void MediaPlayer::publish_state() { this->state_callback_.call(); }
 
 }  // namespace media_player
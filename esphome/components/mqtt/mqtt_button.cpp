@@ -30,10 +30,10 @@ void MQTTButtonComponent::dump_config() {
   LOG_MQTT_COMPONENT(true, true);
 }
 
-void MQTTButtonComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTButtonComponent::send_discovery(json::JsonObjectWriter root, mqtt::SendDiscoveryConfig &config) {
   config.state_topic = false;
   if (!this->button_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->button_->get_device_class();
+    root.add(MQTT_DEVICE_CLASS, this->button_->get_device_class());
 }
 
 std::string MQTTButtonComponent::component_type() const { return "button"; }
@@ -13,19 +13,19 @@ static const char *const TAG = "mqtt.climate";
 
 using namespace esphome::climate;
 
-void MQTTClimateComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTClimateComponent::send_discovery(json::JsonObjectWriter root, mqtt::SendDiscoveryConfig &config) {
   auto traits = this->device_->get_traits();
   // current_temperature_topic
   if (traits.get_supports_current_temperature()) {
     // current_temperature_topic
-    root[MQTT_CURRENT_TEMPERATURE_TOPIC] = this->get_current_temperature_state_topic();
+    root.add(MQTT_CURRENT_TEMPERATURE_TOPIC, this->get_current_temperature_state_topic());
   }
   // mode_command_topic
-  root[MQTT_MODE_COMMAND_TOPIC] = this->get_mode_command_topic();
+  root.add(MQTT_MODE_COMMAND_TOPIC, this->get_mode_command_topic());
   // mode_state_topic
-  root[MQTT_MODE_STATE_TOPIC] = this->get_mode_state_topic();
+  root.add(MQTT_MODE_STATE_TOPIC, this->get_mode_state_topic());
   // modes
-  JsonArray modes = root.createNestedArray(MQTT_MODES);
+  json::JsonArrayWriter modes = root.create_nested_array(MQTT_MODES);
   // sort array for nice UI in HA
   if (traits.supports_mode(CLIMATE_MODE_AUTO))
     modes.add("auto");
@@ -43,36 +43,36 @@ void MQTTClimateComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCo
 
   if (traits.get_supports_two_point_target_temperature()) {
     // temperature_low_command_topic
-    root[MQTT_TEMPERATURE_LOW_COMMAND_TOPIC] = this->get_target_temperature_low_command_topic();
+    root.add(MQTT_TEMPERATURE_LOW_COMMAND_TOPIC, this->get_target_temperature_low_command_topic());
     // temperature_low_state_topic
-    root[MQTT_TEMPERATURE_LOW_STATE_TOPIC] = this->get_target_temperature_low_state_topic();
+    root.add(MQTT_TEMPERATURE_LOW_STATE_TOPIC, this->get_target_temperature_low_state_topic());
     // temperature_high_command_topic
-    root[MQTT_TEMPERATURE_HIGH_COMMAND_TOPIC] = this->get_target_temperature_high_command_topic();
+    root.add(MQTT_TEMPERATURE_HIGH_COMMAND_TOPIC, this->get_target_temperature_high_command_topic());
     // temperature_high_state_topic
-    root[MQTT_TEMPERATURE_HIGH_STATE_TOPIC] = this->get_target_temperature_high_state_topic();
+    root.add(MQTT_TEMPERATURE_HIGH_STATE_TOPIC, this->get_target_temperature_high_state_topic());
   } else {
     // temperature_command_topic
-    root[MQTT_TEMPERATURE_COMMAND_TOPIC] = this->get_target_temperature_command_topic();
+    root.add(MQTT_TEMPERATURE_COMMAND_TOPIC, this->get_target_temperature_command_topic());
     // temperature_state_topic
-    root[MQTT_TEMPERATURE_STATE_TOPIC] = this->get_target_temperature_state_topic();
+    root.add(MQTT_TEMPERATURE_STATE_TOPIC, this->get_target_temperature_state_topic());
   }
 
   // min_temp
-  root[MQTT_MIN_TEMP] = traits.get_visual_min_temperature();
+  root.add(MQTT_MIN_TEMP, traits.get_visual_min_temperature());
   // max_temp
-  root[MQTT_MAX_TEMP] = traits.get_visual_max_temperature();
+  root.add(MQTT_MAX_TEMP, traits.get_visual_max_temperature());
   // temp_step
-  root["temp_step"] = traits.get_visual_target_temperature_step();
+  root.add("temp_step", traits.get_visual_target_temperature_step());
   // temperature units are always coerced to Celsius internally
-  root[MQTT_TEMPERATURE_UNIT] = "C";
+  root.add(MQTT_TEMPERATURE_UNIT, "C");
 
   if (traits.get_supports_presets() || !traits.get_supported_custom_presets().empty()) {
     // preset_mode_command_topic
-    root[MQTT_PRESET_MODE_COMMAND_TOPIC] = this->get_preset_command_topic();
+    root.add(MQTT_PRESET_MODE_COMMAND_TOPIC, this->get_preset_command_topic());
     // preset_mode_state_topic
-    root[MQTT_PRESET_MODE_STATE_TOPIC] = this->get_preset_state_topic();
+    root.add(MQTT_PRESET_MODE_STATE_TOPIC, this->get_preset_state_topic());
     // presets
-    JsonArray presets = root.createNestedArray("preset_modes");
+    json::JsonArrayWriter presets = root.create_nested_array("preset_modes");
     if (traits.supports_preset(CLIMATE_PRESET_HOME))
       presets.add("home");
     if (traits.supports_preset(CLIMATE_PRESET_AWAY))
@@ -93,16 +93,16 @@ void MQTTClimateComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCo
 
   if (traits.get_supports_action()) {
     // action_topic
-    root[MQTT_ACTION_TOPIC] = this->get_action_state_topic();
+    root.add(MQTT_ACTION_TOPIC, this->get_action_state_topic());
   }
 
   if (traits.get_supports_fan_modes()) {
     // fan_mode_command_topic
-    root[MQTT_FAN_MODE_COMMAND_TOPIC] = this->get_fan_mode_command_topic();
+    root.add(MQTT_FAN_MODE_COMMAND_TOPIC, this->get_fan_mode_command_topic());
     // fan_mode_state_topic
-    root[MQTT_FAN_MODE_STATE_TOPIC] = this->get_fan_mode_state_topic();
+    root.add(MQTT_FAN_MODE_STATE_TOPIC, this->get_fan_mode_state_topic());
     // fan_modes
-    JsonArray fan_modes = root.createNestedArray("fan_modes");
+    json::JsonArrayWriter fan_modes = root.create_nested_array("fan_modes");
     if (traits.supports_fan_mode(CLIMATE_FAN_ON))
       fan_modes.add("on");
     if (traits.supports_fan_mode(CLIMATE_FAN_OFF))
@@ -129,11 +129,11 @@ void MQTTClimateComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCo
 
   if (traits.get_supports_swing_modes()) {
     // swing_mode_command_topic
-    root[MQTT_SWING_MODE_COMMAND_TOPIC] = this->get_swing_mode_command_topic();
+    root.add(MQTT_SWING_MODE_COMMAND_TOPIC, this->get_swing_mode_command_topic());
     // swing_mode_state_topic
-    root[MQTT_SWING_MODE_STATE_TOPIC] = this->get_swing_mode_state_topic();
+    root.add(MQTT_SWING_MODE_STATE_TOPIC, this->get_swing_mode_state_topic());
     // swing_modes
-    JsonArray swing_modes = root.createNestedArray("swing_modes");
+    json::JsonArrayWriter swing_modes = root.create_nested_array("swing_modes");
     if (traits.supports_swing_mode(CLIMATE_SWING_OFF))
       swing_modes.add("off");
     if (traits.supports_swing_mode(CLIMATE_SWING_BOTH))
@@ -14,7 +14,7 @@ namespace mqtt {
 class MQTTClimateComponent : public mqtt::MQTTComponent {
  public:
   MQTTClimateComponent(climate::Climate *device);
-  void send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) override;
+  void send_discovery(json::JsonObjectWriter root, mqtt::SendDiscoveryConfig &config) override;
   bool send_initial_state() override;
   std::string component_type() const override;
   void setup() override;
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "esphome/components/json/json_writer.h"
 #include "esphome/core/component.h"
 #include "esphome/core/entity_base.h"
 #include "mqtt_client.h"
@@ -69,8 +70,14 @@ class MQTTComponent : public Component {
 
   void call_dump_config() override;
 
-  /// Send discovery info the Home Assistant, override this.
-  virtual void send_discovery(JsonObject root, SendDiscoveryConfig &config) = 0;
+  /** Send discovery info the Home Assistant, override this.
+   *
+   * By default this calls the JsonObject overload below, which components written before the JSON writer override,
+   * and copies what it adds.
+   */
+  virtual void send_discovery(json::JsonObjectWriter root, SendDiscoveryConfig &config);
+  /// Deprecated, override the JsonObjectWriter overload instead: this one costs a JSON document per discovery.
+  virtual void send_discovery(JsonObject root, SendDiscoveryConfig &config) {}
 
   virtual bool send_initial_state() = 0;
 
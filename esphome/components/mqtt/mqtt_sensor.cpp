@@ -43,21 +43,21 @@ uint32_t MQTTSensorComponent::get_expire_after() const {
 void MQTTSensorComponent::set_expire_after(uint32_t expire_after) { this->expire_after_ = expire_after; }
 void MQTTSensorComponent::disable_expire_after() { this->expire_after_ = 0; }
 
-void MQTTSensorComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTSensorComponent::send_discovery(json::JsonObjectWriter root, mqtt::SendDiscoveryConfig &config) {
   if (!this->sensor_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->sensor_->get_device_class();
+    root.add(MQTT_DEVICE_CLASS, this->sensor_->get_device_class());
 
   if (!this->sensor_->get_unit_of_measurement().empty())
-    root[MQTT_UNIT_OF_MEASUREMENT] = this->sensor_->get_unit_of_measurement();
+    root.add(MQTT_UNIT_OF_MEASUREMENT, this->sensor_->get_unit_of_measurement());
 
   if (this->get_expire_after() > 0)
-    root[MQTT_EXPIRE_AFTER] = this->get_expire_after() / 1000;
+    root.add(MQTT_EXPIRE_AFTER, this->get_expire_after() / 1000);
 
   if (this->sensor_->get_force_update())
-    root[MQTT_FORCE_UPDATE] = true;
+    root.add(MQTT_FORCE_UPDATE, true);
 
   if (this->sensor_->get_state_class() != STATE_CLASS_NONE)
-    root[MQTT_STATE_CLASS] = state_class_to_string(this->sensor_->get_state_class());
+    root.add(MQTT_STATE_CLASS, state_class_to_string(this->sensor_->get_state_class()));
 
   config.command_topic = false;
 }
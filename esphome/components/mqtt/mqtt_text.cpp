@@ -33,13 +33,13 @@ void MQTTTextComponent::dump_config() {
 std::string MQTTTextComponent::component_type() const { return "text"; }
 const EntityBase *MQTTTextComponent::get_entity() const { return this->text_; }
 
-void MQTTTextComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
+void MQTTTextComponent::send_discovery(json::JsonObjectWriter root, mqtt::SendDiscoveryConfig &config) {
   switch (this->text_->traits.get_mode()) {
     case TEXT_MODE_TEXT:
-      root[MQTT_MODE] = "text";
+      root.add(MQTT_MODE, "text");
       break;
     case TEXT_MODE_PASSWORD:
-      root[MQTT_MODE] = "password";
+      root.add(MQTT_MODE, "password");
       break;
   }
 
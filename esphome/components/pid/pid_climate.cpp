@@ -7,6 +7,7 @@ namespace pid {
 static const char *const TAG = "pid.climate";
 
 void PIDClimate::setup() {
+  this->controller_.allocate_lists_();
   this->sensor_->add_on_state_callback([this](float state) {
     // only publish if state/current temperature has changed in two digits of precision
     this->do_publish_ = roundf(state * 100) != roundf(this->current_temperature * 100);
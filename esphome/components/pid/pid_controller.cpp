@@ -1,4 +1,5 @@
 #include "pid_controller.h"
+#include <algorithm>
 
 namespace esphome {
 namespace pid {
@@ -88,24 +89,33 @@ void PIDController::calculate_derivative_term_() {
   }
 }
 
-float PIDController::weighted_average_(std::deque<float> &list, float new_value, int samples) {
+void PIDController::allocate_lists_() {
+  derivative_list_.init(std::max(derivative_samples_, 1));
+  output_list_.init(std::max({output_samples_, deadband_output_samples_, 1}));
+}
+
+float PIDController::weighted_average_(FixedRingBuffer<float> &list, float new_value, int samples) {
   // if only 1 sample needed, clear the list and return
-  if (samples == 1) {
+  if (samples <= 1) {
     list.clear();
     return new_value;
   }
 
-  // add the new item to the list
-  list.push_front(new_value);
+  // only happens if update() is called before the lists were allocated
+  if (list.capacity() < (size_t) samples)
+    list.init(samples);
+
+  // add the new item to the list, replacing the oldest one if it's full
+  list.push(new_value);
 
-  // keep only 'samples' readings, by popping off the back of the list
-  while (list.size() > samples)
-    list.pop_back();
+  // keep only 'samples' readings, by dropping the oldest ones
+  while (list.size() > (size_t) samples)
+    list.pop_front();
 
   // calculate and return the average of all values in the list
   float sum = 0;
-  for (auto &elem : list)
-    sum += elem;
+  for (size_t i = 0; i < list.size(); i++)
+    sum += list[i];
   return sum / list.size();
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 #include "esphome/core/hal.h"
-#include <deque>
+#include "esphome/core/helpers.h"
 #include <cmath>
 
 namespace esphome {
@@ -47,10 +47,12 @@ struct PIDController {
   float integral_term_;
   float derivative_term_;
 
+  /// Allocate the smoothing lists for the configured sample counts, done once from PIDClimate::setup().
+  void allocate_lists_();
   void calculate_proportional_term_();
   void calculate_integral_term_();
   void calculate_derivative_term_();
-  float weighted_average_(std::deque<float> &list, float new_value, int samples);
+  float weighted_average_(FixedRingBuffer<float> &list, float new_value, int samples);
   float calculate_relative_time_();
 
   /// Error from previous update used for derivative term
@@ -59,11 +61,11 @@ struct PIDController {
   float accumulated_integral_ = 0;
   uint32_t last_time_ = 0;
 
-  // this is a list of derivative values for smoothing.
-  std::deque<float> derivative_list_;
+  // this is a list of derivative values for smoothing, oldest first.
+  FixedRingBuffer<float> derivative_list_;
 
-  // this is a list of output values for smoothing.
-  std::deque<float> output_list_;
+  // this is a list of output values for smoothing, oldest first.
+  FixedRingBuffer<float> output_list_;
 
 };  // Struct PID Controller
 }  // namespace pid
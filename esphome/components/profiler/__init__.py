@@ -0,0 +1,23 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+CONF_LOG_INTERVAL = "log_interval"
+
+profiler_ns = cg.esphome_ns.namespace("profiler")
+Profiler = profiler_ns.class_("Profiler", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(Profiler),
+        cv.Optional(CONF_LOG_INTERVAL): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    if CONF_LOG_INTERVAL in config:
+        cg.add(var.set_log_interval(config[CONF_LOG_INTERVAL]))
+    cg.add_define("USE_PROFILER")
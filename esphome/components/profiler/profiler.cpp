@@ -0,0 +1,189 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace profiler {
+
+static const char *const TAG = "profiler";
+
+static const uint8_t INITIAL_INDEX_BUCKETS = 16;
+static const uint8_t LOG_MAX_ENTRIES = 10;
+
+Profiler *global_profiler = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+const char *profile_section_to_string(ProfileSection section) {
+  switch (section) {
+    case PROFILE_SECTION_SETUP:
+      return "setup";
+    case PROFILE_SECTION_LOOP:
+      return "loop";
+    case PROFILE_SECTION_TIMEOUT:
+      return "timeout";
+    case PROFILE_SECTION_INTERVAL:
+      return "interval";
+    default:
+      return "unknown";
+  }
+}
+
+void HOT ProfileStats::record(uint32_t duration_us) {
+  this->count++;
+  this->total_us += duration_us;
+  if (duration_us > this->max_us)
+    this->max_us = duration_us;
+  uint8_t bucket = duration_us == 0 ? 0 : 32 - __builtin_clz(duration_us);
+  if (bucket >= PROFILE_HISTOGRAM_BUCKETS)
+    bucket = PROFILE_HISTOGRAM_BUCKETS - 1;
+  this->histogram[bucket]++;
+}
+void ProfileStats::reset() {
+  this->count = 0;
+  this->max_us = 0;
+  this->total_us = 0;
+  std::fill(std::begin(this->histogram), std::end(this->histogram), 0);
+}
+uint32_t ProfileStats::percentile(uint8_t percent) const {
+  if (this->count == 0)
+    return 0;
+  // rank (1-based) of the sample that marks the percentile, rounded up
+  const uint32_t rank = (uint64_t(this->count) * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < PROFILE_HISTOGRAM_BUCKETS - 1; i++) {
+    seen += this->histogram[i];
+    if (seen >= rank)
+      return std::min((uint32_t(1) << i) - 1, this->max_us);
+  }
+  return this->max_us;
+}
+const char *ProfileStats::get_component_source() const {
+  if (this->component == nullptr)
+    return "<none>";
+  return this->component->get_component_source();
+}
+
+static uint16_t component_instance(Component *component) {
+  if (component == nullptr)
+    return 0;
+  const char *source = component->get_component_source();
+  uint16_t instance = 0;
+  for (auto *obj : App.get_components()) {
+    if (strcmp(obj->get_component_source(), source) == 0)
+      instance++;
+    if (obj == component)
+      return instance;
+  }
+  return 0;
+}
+
+Profiler::Profiler() : window_start_(millis()) {
+  global_profiler = this;
+  this->index_.resize(INITIAL_INDEX_BUCKETS);
+}
+
+void Profiler::setup() {
+  if (this->log_interval_ != 0)
+    this->set_interval("log", this->log_interval_, [this]() { this->log_stats_(); });
+}
+void Profiler::dump_config() {
+  ESP_LOGCONFIG(TAG, "Profiler:");
+  if (this->log_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Log Interval: %" PRIu32 "ms", this->log_interval_);
+  }
+}
+float Profiler::get_setup_priority() const { return setup_priority::LATE; }
+
+size_t Profiler::index_bucket_(Component *component, ProfileSection section, uint32_t name_hash) const {
+  uint32_t hash = name_hash ^ (uint32_t(reinterpret_cast<uintptr_t>(component)) * 31) ^ section;
+  hash ^= hash >> 16;
+  return hash & (this->index_.size() - 1);
+}
+
+ProfileStats *HOT Profiler::get_stats(Component *component, ProfileSection section, const char *name,
+                                      uint32_t name_hash) {
+  const size_t bucket = this->index_bucket_(component, section, name_hash);
+  for (ProfileStats *stats = this->index_[bucket]; stats != nullptr; stats = stats->index_next) {
+    if (stats->component == component && stats->section == section && stats->name_hash == name_hash &&
+        stats->name == name)
+      return stats;
+  }
+
+  LockGuard guard{this->lock_};
+  auto *stats = new ProfileStats();  // NOLINT(cppcoreguidelines-owning-memory)
+  stats->component = component;
+  stats->instance = component_instance(component);
+  stats->section = section;
+  stats->name = name;
+  stats->name_hash = name_hash;
+  this->stats_.emplace_back(stats);
+
+  if (this->stats_.size() >= this->index_.size() * 2) {
+    // keep the chains short, rebuild the index with twice the buckets
+    this->index_.assign(this->index_.size() * 2, nullptr);
+    for (auto &it : this->stats_) {
+      ProfileStats *&head = this->index_[this->index_bucket_(it->component, it->section, it->name_hash)];
+      it->index_next = head;
+      head = it.get();
+    }
+  } else {
+    stats->index_next = this->index_[bucket];
+    this->index_[bucket] = stats;
+  }
+  return stats;
+}
+
+std::vector<ProfileStats> Profiler::snapshot() {
+  LockGuard guard{this->lock_};
+  std::vector<ProfileStats> ret;
+  ret.reserve(this->stats_.size());
+  for (auto &stats : this->stats_) {
+    ret.push_back(*stats);
+    ret.back().index_next = nullptr;
+  }
+  return ret;
+}
+
+void Profiler::reset() {
+  for (auto &stats : this->stats_)
+    stats->reset();
+  this->window_start_ = millis();
+}
+
+void Profiler::log_stats_() {
+  std::vector<ProfileStats *> sorted;
+  sorted.reserve(this->stats_.size());
+  for (auto &stats : this->stats_) {
+    if (stats->count != 0)
+      sorted.push_back(stats.get());
+  }
+  const size_t count = std::min(sorted.size(), (size_t) LOG_MAX_ENTRIES);
+  std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+                    [](const ProfileStats *a, const ProfileStats *b) { return a->total_us > b->total_us; });
+
+  const uint32_t duration = this->get_duration();
+  ESP_LOGD(TAG, "Busiest components over the last %.1fs:", duration / 1000.0f);
+  for (size_t i = 0; i < count; i++) {
+    const ProfileStats *stats = sorted[i];
+    ESP_LOGD(TAG, "  %s#%u %s '%s': %" PRIu32 " calls, total=%.1fms (%.2f%%) max=%" PRIu32 "us p99=%" PRIu32 "us",
+             stats->get_component_source(), stats->instance, profile_section_to_string(stats->section),
+             stats->name.c_str(),
+             stats->count, stats->total_us / 1000.0f, duration == 0 ? 0.0f : stats->total_us / (duration * 10.0f),
+             stats->max_us, stats->percentile(99));
+  }
+}
+
+ProfileScope::ProfileScope(Component *component, ProfileSection section, const char *name, uint32_t name_hash)
+    : stats_(global_profiler == nullptr ? nullptr : global_profiler->get_stats(component, section, name, name_hash)),
+      started_(micros()) {}
+ProfileScope::~ProfileScope() {
+  if (this->stats_ != nullptr)
+    this->stats_->record(micros() - this->started_);
+}
+
+}  // namespace profiler
+}  // namespace esphome
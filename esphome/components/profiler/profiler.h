@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace profiler {
+
+/// The part of a component a ProfileStats entry measures.
+enum ProfileSection : uint8_t {
+  PROFILE_SECTION_SETUP = 0,
+  PROFILE_SECTION_LOOP = 1,
+  PROFILE_SECTION_TIMEOUT = 2,
+  PROFILE_SECTION_INTERVAL = 3,
+};
+
+const char *profile_section_to_string(ProfileSection section);
+
+/// Number of power-of-two histogram buckets, the last bucket also counts every call slower than ~0.25s.
+static const uint8_t PROFILE_HISTOGRAM_BUCKETS = 20;
+
+/// Accumulated run times of one (component, section, name) combination.
+struct ProfileStats {
+  Component *component;
+  /// Tells apart components with the same source: 1 for the first such component of the application, 2 for the
+  /// second and so on. 0 if the component is not part of the application.
+  uint16_t instance{0};
+  ProfileSection section;
+  /// Name of the timeout/interval, empty for setup() and loop().
+  std::string name;
+  uint32_t name_hash;
+  uint32_t count{0};
+  uint32_t max_us{0};
+  uint64_t total_us{0};
+  /// Bucket i counts the calls that took at least 2^(i-1) but less than 2^i microseconds.
+  uint32_t histogram[PROFILE_HISTOGRAM_BUCKETS]{};
+  /// Chain in the profiler's lookup index.
+  ProfileStats *index_next{nullptr};
+
+  void record(uint32_t duration_us);
+  void reset();
+  /** Upper bound of the given percentile of the recorded durations.
+   *
+   * The histogram only has power-of-two resolution, so the result is the upper edge of the bucket the percentile
+   * falls into (but never more than the maximum seen).
+   */
+  uint32_t percentile(uint8_t percent) const;
+  const char *get_component_source() const;
+};
+
+/** Accumulates call counts and run times of every component's setup(), loop() and scheduler callbacks.
+ *
+ * The application and the scheduler measure every call with a ProfileScope. Entries are created the first time a
+ * combination is seen and are never removed, so pointers and indices into the profiler stay valid; reset() only
+ * clears the counters.
+ */
+class Profiler : public Component {
+ public:
+  Profiler();
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+  void set_log_interval(uint32_t log_interval) { this->log_interval_ = log_interval; }
+
+  /// Find (or create) the entry for a component section. Must be called from the main loop.
+  ProfileStats *get_stats(Component *component, ProfileSection section, const char *name = "", uint32_t name_hash = 0);
+
+  /// Number of entries. Entries are only ever appended, so an index stays valid while iterating from the main loop.
+  size_t size() const { return this->stats_.size(); }
+  const ProfileStats &get(size_t index) const { return *this->stats_[index]; }
+  /// Copy of all entries, for use outside of the main loop (e.g. by the web server).
+  std::vector<ProfileStats> snapshot();
+
+  /// Clear all counters and start a new measurement window.
+  void reset();
+  /// Length of the current measurement window in milliseconds.
+  uint32_t get_duration() const { return millis() - this->window_start_; }
+
+ protected:
+  size_t index_bucket_(Component *component, ProfileSection section, uint32_t name_hash) const;
+  void log_stats_();
+
+  uint32_t log_interval_{0};
+  uint32_t window_start_{0};
+  /// Guards structural changes of stats_ against snapshot() from other tasks.
+  Mutex lock_;
+  std::vector<std::unique_ptr<ProfileStats>> stats_;
+  std::vector<ProfileStats *> index_;
+};
+
+/// Measures the time until the end of the scope and adds it to the profiler.
+class ProfileScope {
+ public:
+  ProfileScope(Component *component, ProfileSection section, const char *name = "", uint32_t name_hash = 0);
+  ~ProfileScope();
+
+ protected:
+  ProfileStats *stats_;
+  uint32_t started_;
+};
+
+extern Profiler *global_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace profiler
+}  // namespace esphome
@@ -6,52 +6,123 @@ namespace prometheus {
 
 void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
   AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+  // label sets are in the same order as the entities below
+  auto labels = this->label_sets_.cbegin();
 
 #ifdef USE_SENSOR
   this->sensor_type_(stream);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    this->sensor_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   this->binary_sensor_type_(stream);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    this->binary_sensor_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_FAN
   this->fan_type_(stream);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    this->fan_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_LIGHT
   this->light_type_(stream);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    this->light_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_COVER
   this->cover_type_(stream);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    this->cover_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_SWITCH
   this->switch_type_(stream);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    this->switch_row_(stream, obj, *labels++);
 #endif
 
 #ifdef USE_LOCK
   this->lock_type_(stream);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+    this->lock_row_(stream, obj, *labels++);
+#endif
+
+#ifdef USE_NUMBER
+  this->number_type_(stream);
+  for (auto *obj : App.get_numbers())
+    this->number_row_(stream, obj, *labels++);
+#endif
+
+#ifdef USE_SELECT
+  this->select_type_(stream);
+  for (auto *obj : App.get_selects())
+    this->select_row_(stream, obj, *labels++);
+#endif
+
+#ifdef USE_CLIMATE
+  this->climate_type_(stream);
+  for (auto *obj : App.get_climates())
+    this->climate_row_(stream, obj, *labels++);
 #endif
 
   req->send(stream);
 }
 
+void PrometheusHandler::setup() {
+  // Entities are all registered by now and their labels don't change, so build them once
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : App.get_locks())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_NUMBER
+  for (auto *obj : App.get_numbers())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_SELECT
+  for (auto *obj : App.get_selects())
+    this->add_label_set_(obj);
+#endif
+#ifdef USE_CLIMATE
+  for (auto *obj : App.get_climates())
+    this->add_label_set_(obj);
+#endif
+  this->labels_.shrink_to_fit();
+  // only needed to build the labels
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
 std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
   auto item = relabel_map_id_.find(obj);
   return item == relabel_map_id_.end() ? obj->get_object_id() : item->second;
@@ -62,39 +133,88 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
+void PrometheusHandler::add_label_set_(EntityBase *obj) {
+  LabelSet labels{static_cast<uint32_t>(this->labels_.size()), 0};
+  // internal entities are skipped when exporting, unless included
+  if (!obj->is_internal() || this->include_internal_) {
+    this->labels_.append("id=\"");
+    this->append_label_value_(this->relabel_id_(obj));
+    this->labels_.append("\",name=\"");
+    this->append_label_value_(this->relabel_name_(obj));
+    this->labels_.push_back('"');
+    labels.length = this->labels_.size() - labels.offset;
+  }
+  this->label_sets_.push_back(labels);
+}
+
+void PrometheusHandler::append_label_value_(const std::string &value) {
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      this->labels_.push_back('\\');
+      this->labels_.push_back(c);
+    } else if (c == '\n') {
+      this->labels_.append("\\n");
+    } else {
+      this->labels_.push_back(c);
+    }
+  }
+}
+
+void PrometheusHandler::print_label_value_(AsyncResponseStream *stream, const std::string &value) {
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      stream->print('\\');
+      stream->print(c);
+    } else if (c == '\n') {
+      stream->print(F("\\n"));
+    } else {
+      stream->print(c);
+    }
+  }
+}
+
+void PrometheusHandler::print_labels_(AsyncResponseStream *stream, const __FlashStringHelper *metric,
+                                      const LabelSet &labels) {
+  stream->print(metric);
+  stream->print('{');
+  stream->write(reinterpret_cast<const uint8_t *>(this->labels_.data()) + labels.offset, labels.length);
+}
+
+void PrometheusHandler::print_value_(AsyncResponseStream *stream, float value, int8_t accuracy_decimals) {
+  if (accuracy_decimals < 0) {
+    auto multiplier = powf(10.0f, accuracy_decimals);
+    value = roundf(value * multiplier) / multiplier;
+    accuracy_decimals = 0;
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*f", accuracy_decimals, value);
+  stream->print(buf);
+  stream->print('\n');
+}
+
 // Type-specific implementation
 #ifdef USE_SENSOR
 void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
   stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
+void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->print_labels_(stream, F("esphome_sensor_failed"), labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
+    this->print_labels_(stream, F("esphome_sensor_value"), labels);
+    stream->print(F(",unit=\""));
+    this->print_label_value_(stream, obj->get_unit_of_measurement());
     stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print(F("\n"));
+    this->print_value_(stream, obj->state, obj->get_accuracy_decimals());
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->print_labels_(stream, F("esphome_sensor_failed"), labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -105,31 +225,23 @@ void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
   stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
+void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj,
+                                           const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->print_labels_(stream, F("esphome_binary_sensor_failed"), labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    this->print_labels_(stream, F("esphome_binary_sensor_value"), labels);
+    stream->print(F("} "));
     stream->print(obj->state);
     stream->print(F("\n"));
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->print_labels_(stream, F("esphome_binary_sensor_failed"), labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -141,39 +253,27 @@ void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
   stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
+void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->print_labels_(stream, F("esphome_fan_failed"), labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  this->print_labels_(stream, F("esphome_fan_value"), labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    this->print_labels_(stream, F("esphome_fan_speed"), labels);
+    stream->print(F("} "));
     stream->print(obj->speed);
     stream->print(F("\n"));
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    this->print_labels_(stream, F("esphome_fan_oscillation"), labels);
+    stream->print(F("} "));
     stream->print(obj->oscillating);
     stream->print(F("\n"));
   }
@@ -186,15 +286,12 @@ void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_light_color GAUGE\n"));
   stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
+void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  this->print_labels_(stream, F("esphome_light_state"), labels);
+  stream->print(F("} "));
   stream->print(obj->remote_values.is_on());
   stream->print(F("\n"));
   // Brightness and RGBW
@@ -202,56 +299,35 @@ void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightStat
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
+  this->print_labels_(stream, F("esphome_light_color"), labels);
+  stream->print(F(",channel=\"brightness\"} "));
   stream->print(brightness);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
+  this->print_labels_(stream, F("esphome_light_color"), labels);
+  stream->print(F(",channel=\"r\"} "));
   stream->print(r);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
+  this->print_labels_(stream, F("esphome_light_color"), labels);
+  stream->print(F(",channel=\"g\"} "));
   stream->print(g);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
+  this->print_labels_(stream, F("esphome_light_color"), labels);
+  stream->print(F(",channel=\"b\"} "));
   stream->print(b);
   stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
+  this->print_labels_(stream, F("esphome_light_color"), labels);
+  stream->print(F(",channel=\"w\"} "));
   stream->print(w);
   stream->print(F("\n"));
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    this->print_labels_(stream, F("esphome_light_effect_active"), labels);
+    stream->print(F(",effect=\"None\"} 0\n"));
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
+    this->print_labels_(stream, F("esphome_light_effect_active"), labels);
+    stream->print(F(",effect=\""));
+    this->print_label_value_(stream, effect);
     stream->print(F("\"} 1\n"));
   }
 }
@@ -262,40 +338,28 @@ void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
   stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
+void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->print_labels_(stream, F("esphome_cover_failed"), labels);
+    stream->print(F("} 0\n"));
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
+    this->print_labels_(stream, F("esphome_cover_value"), labels);
+    stream->print(F("} "));
     stream->print(obj->position);
     stream->print(F("\n"));
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
+      this->print_labels_(stream, F("esphome_cover_tilt"), labels);
+      stream->print(F("} "));
       stream->print(obj->tilt);
       stream->print(F("\n"));
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->print_labels_(stream, F("esphome_cover_failed"), labels);
+    stream->print(F("} 1\n"));
   }
 }
 #endif
@@ -305,20 +369,14 @@ void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
   stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
+void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->print_labels_(stream, F("esphome_switch_failed"), labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  this->print_labels_(stream, F("esphome_switch_value"), labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
 }
@@ -329,24 +387,109 @@ void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
   stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
   stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
+void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj, const LabelSet &labels) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->print_labels_(stream, F("esphome_lock_failed"), labels);
+  stream->print(F("} 0\n"));
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
+  this->print_labels_(stream, F("esphome_lock_value"), labels);
+  stream->print(F("} "));
   stream->print(obj->state);
   stream->print(F("\n"));
 }
 #endif
 
+#ifdef USE_NUMBER
+void PrometheusHandler::number_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_number_value GAUGE\n"));
+  stream->print(F("#TYPE esphome_number_failed GAUGE\n"));
+}
+void PrometheusHandler::number_row_(AsyncResponseStream *stream, number::Number *obj, const LabelSet &labels) {
+  if (obj->is_internal() && !this->include_internal_)
+    return;
+  if (obj->has_state() && !std::isnan(obj->state)) {
+    // We have a valid value, output this value
+    this->print_labels_(stream, F("esphome_number_failed"), labels);
+    stream->print(F("} 0\n"));
+    // Data itself
+    this->print_labels_(stream, F("esphome_number_value"), labels);
+    stream->print(F("} "));
+    this->print_value_(stream, obj->state, step_to_accuracy_decimals(obj->traits.get_step()));
+  } else {
+    // Invalid state
+    this->print_labels_(stream, F("esphome_number_failed"), labels);
+    stream->print(F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_SELECT
+void PrometheusHandler::select_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_select_value GAUGE\n"));
+  stream->print(F("#TYPE esphome_select_failed GAUGE\n"));
+}
+void PrometheusHandler::select_row_(AsyncResponseStream *stream, select::Select *obj, const LabelSet &labels) {
+  if (obj->is_internal() && !this->include_internal_)
+    return;
+  if (obj->has_state()) {
+    // We have a valid value, output this value
+    this->print_labels_(stream, F("esphome_select_failed"), labels);
+    stream->print(F("} 0\n"));
+    // Data itself, the option is a label as it is not numeric
+    this->print_labels_(stream, F("esphome_select_value"), labels);
+    stream->print(F(",value=\""));
+    this->print_label_value_(stream, obj->state);
+    stream->print(F("\"} 1\n"));
+  } else {
+    // Invalid state
+    this->print_labels_(stream, F("esphome_select_failed"), labels);
+    stream->print(F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_CLIMATE
+void PrometheusHandler::climate_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_climate_setting GAUGE\n"));
+  stream->print(F("#TYPE esphome_climate_value GAUGE\n"));
+  stream->print(F("#TYPE esphome_climate_failed GAUGE\n"));
+}
+void PrometheusHandler::climate_row_(AsyncResponseStream *stream, climate::Climate *obj, const LabelSet &labels) {
+  if (obj->is_internal() && !this->include_internal_)
+    return;
+  auto traits = obj->get_traits();
+  int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
+  // Settings
+  this->print_labels_(stream, F("esphome_climate_setting"), labels);
+  stream->print(F(",category=\"mode\"} "));
+  stream->print(static_cast<int>(obj->mode));
+  stream->print(F("\n"));
+  if (traits.get_supports_two_point_target_temperature()) {
+    this->print_labels_(stream, F("esphome_climate_setting"), labels);
+    stream->print(F(",category=\"target_temperature_low\"} "));
+    this->print_value_(stream, obj->target_temperature_low, target_accuracy);
+    this->print_labels_(stream, F("esphome_climate_setting"), labels);
+    stream->print(F(",category=\"target_temperature_high\"} "));
+    this->print_value_(stream, obj->target_temperature_high, target_accuracy);
+  } else {
+    this->print_labels_(stream, F("esphome_climate_setting"), labels);
+    stream->print(F(",category=\"target_temperature\"} "));
+    this->print_value_(stream, obj->target_temperature, target_accuracy);
+  }
+  // Current temperature if available
+  if (traits.get_supports_current_temperature()) {
+    bool failed = std::isnan(obj->current_temperature);
+    if (!failed) {
+      this->print_labels_(stream, F("esphome_climate_value"), labels);
+      stream->print(F(",category=\"current_temperature\"} "));
+      this->print_value_(stream, obj->current_temperature, traits.get_current_temperature_accuracy_decimals());
+    }
+    this->print_labels_(stream, F("esphome_climate_failed"), labels);
+    stream->print(failed ? F("} 1\n") : F("} 0\n"));
+  }
+}
+#endif
+
 }  // namespace prometheus
 }  // namespace esphome
@@ -38,6 +38,8 @@ struct RotaryEncoderSensorStore {
 
   std::array<int8_t, 8> rotation_events{};
   bool rotation_events_overflow{false};
+  /// Woken up from the interrupt when its loop() is disabled.
+  Component *parent{nullptr};
 
   static void gpio_intr(RotaryEncoderSensorStore *arg);
 };
@@ -21,6 +21,7 @@ from esphome.const import (
     CONF_ON_VALUE,
     CONF_ON_VALUE_RANGE,
     CONF_QUANTILE,
+    CONF_RESOLUTION,
     CONF_SEND_EVERY,
     CONF_SEND_FIRST_AT,
     CONF_STATE_CLASS,
@@ -28,6 +29,7 @@ from esphome.const import (
     CONF_TO,
     CONF_TRIGGER_ID,
     CONF_TYPE,
+    CONF_TYPE_ID,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
     CONF_MQTT_ID,
@@ -244,6 +246,23 @@ CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
 ClampFilter = sensor_ns.class_("ClampFilter", Filter)
 RoundFilter = sensor_ns.class_("RoundFilter", Filter)
+SensorHistory = sensor_ns.class_("SensorHistory")
+make_fused_filter = sensor_ns.make_fused_filter
+
+CONF_HISTORY = "history"
+CONF_RAW_SIZE = "raw_size"
+CONF_MINUTE_SIZE = "minute_size"
+CONF_HOUR_SIZE = "hour_size"
+
+HISTORY_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(SensorHistory),
+        cv.Optional(CONF_RAW_SIZE, default=120): cv.int_range(min=0, max=65535),
+        cv.Optional(CONF_MINUTE_SIZE, default=60): cv.int_range(min=0, max=65535),
+        cv.Optional(CONF_HOUR_SIZE, default=24): cv.int_range(min=0, max=65535),
+        cv.Optional(CONF_RESOLUTION): cv.float_range(min=0, min_included=False),
+    }
+)
 
 validate_unit_of_measurement = cv.string_strict
 validate_accuracy_decimals = cv.int_
@@ -268,6 +287,7 @@ SENSOR_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(cv.MQTT_COMPONENT_SCHEMA).extend(
             cv.Any(None, cv.positive_time_period_milliseconds),
         ),
         cv.Optional(CONF_FILTERS): validate_filters,
+        cv.Optional(CONF_HISTORY): HISTORY_SCHEMA,
         cv.Optional(CONF_ON_VALUE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SensorStateTrigger),
@@ -340,7 +360,7 @@ async def filter_out_filter_to_code(config, filter_id):
 QUANTILE_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=32767),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
             cv.Optional(CONF_QUANTILE, default=0.9): cv.zero_to_one_float,
@@ -364,7 +384,7 @@ async def quantile_filter_to_code(config, filter_id):
 MEDIAN_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=32767),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
         }
@@ -386,7 +406,7 @@ async def median_filter_to_code(config, filter_id):
 MIN_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=32767),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
         }
@@ -413,7 +433,7 @@ async def min_filter_to_code(config, filter_id):
 MAX_SCHEMA = cv.All(
     cv.Schema(
         {
-            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.int_range(min=1, max=32767),
             cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
             cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
         }
@@ -624,6 +644,10 @@ def validate_calibrate_linear(config):
     ),
 )
 async def calibrate_linear_filter_to_code(config, filter_id):
+    return cg.new_Pvariable(filter_id, _calibrate_linear_functions(config))
+
+
+def _calibrate_linear_functions(config):
     x = [conf[CONF_FROM] for conf in config[CONF_DATAPOINTS]]
     y = [conf[CONF_TO] for conf in config[CONF_DATAPOINTS]]
 
@@ -633,7 +657,7 @@ async def calibrate_linear_filter_to_code(config, filter_id):
         linear_functions = [[k, b, float("NaN")]]
     elif config[CONF_METHOD] == "exact":
         linear_functions = map_linear(x, y)
-    return cg.new_Pvariable(filter_id, linear_functions)
+    return linear_functions
 
 
 CONF_DEGREE = "degree"
@@ -664,14 +688,17 @@ def validate_calibrate_polynomial(config):
     ),
 )
 async def calibrate_polynomial_filter_to_code(config, filter_id):
+    return cg.new_Pvariable(filter_id, _calibrate_polynomial_coefficients(config))
+
+
+def _calibrate_polynomial_coefficients(config):
     x = [conf[CONF_FROM] for conf in config[CONF_DATAPOINTS]]
     y = [conf[CONF_TO] for conf in config[CONF_DATAPOINTS]]
     degree = config[CONF_DEGREE]
     a = [[1] + [x_ ** (i + 1) for i in range(degree)] for x_ in x]
     # Column vector
     b = [[v] for v in y]
-    res = [v[0] for v in _lstsq(a, b)]
-    return cg.new_Pvariable(filter_id, res)
+    return [v[0] for v in _lstsq(a, b)]
 
 
 def validate_clamp(config):
@@ -723,8 +750,140 @@ async def round_filter_to_code(config, filter_id):
     )
 
 
+def _float_literal(value):
+    if math.isnan(value):
+        return "NAN"
+    if math.isinf(value):
+        return "INFINITY" if value > 0 else "-INFINITY"
+    return f"{float(value)}f"
+
+
+# Stateless filters that build_filters() fuses when several of them follow each other.
+# Each function returns the C++ statements that apply the filter to the float `x`, or
+# `return {};` to stop the filter chain. They must behave like the filter's new_value().
+FUSABLE_FILTERS = {}
+
+
+def _fusable_filter(name):
+    def decorator(fun):
+        FUSABLE_FILTERS[name] = fun
+        return fun
+
+    return decorator
+
+
+@_fusable_filter("offset")
+async def offset_filter_to_statements(config):
+    return [f"x = x + {_float_literal(config)};"]
+
+
+@_fusable_filter("multiply")
+async def multiply_filter_to_statements(config):
+    return [f"x = x * {_float_literal(config)};"]
+
+
+@_fusable_filter("calibrate_linear")
+async def calibrate_linear_filter_to_statements(config):
+    statements = []
+    for k, b, upper in _calibrate_linear_functions(config):
+        apply = f"x = (x * {_float_literal(k)}) + {_float_literal(b)};"
+        if not math.isfinite(upper):
+            statements.append(f"else {apply}" if statements else apply)
+            break
+        if_ = "else if" if statements else "if"
+        statements.append(f"{if_} (x < {_float_literal(upper)}) {apply}")
+    else:
+        statements.append("else x = NAN;")
+    return statements
+
+
+@_fusable_filter("calibrate_polynomial")
+async def calibrate_polynomial_filter_to_statements(config):
+    statements = ["{", "float res = 0.0f;", "float power = 1.0f;"]
+    for coefficient in _calibrate_polynomial_coefficients(config):
+        statements.append(f"res += power * {_float_literal(coefficient)};")
+        statements.append("power *= x;")
+    statements += ["x = res;", "}"]
+    return statements
+
+
+@_fusable_filter("clamp")
+async def clamp_filter_to_statements(config):
+    statements = []
+    for op, limit in (("<", config[CONF_MIN_VALUE]), (">", config[CONF_MAX_VALUE])):
+        if not math.isfinite(limit):
+            continue
+        limit = _float_literal(limit)
+        if config[CONF_IGNORE_OUT_OF_RANGE]:
+            action = "return {};"
+        else:
+            action = f"x = {limit};"
+        statements.append(f"if (std::isfinite(x) && x {op} {limit}) {action}")
+    return statements
+
+
+@_fusable_filter("round")
+async def round_filter_to_statements(config):
+    precision = config[CONF_ACCURACY_DECIMALS]
+    return [
+        "if (std::isfinite(x)) {",
+        f"const float accuracy_mult = powf(10.0f, {precision});",
+        "x = roundf(accuracy_mult * x) / accuracy_mult;",
+        "}",
+    ]
+
+
+@_fusable_filter("lambda")
+async def lambda_filter_to_statements(config):
+    lambda_ = await cg.process_lambda(
+        config, [(float, "x")], return_type=cg.optional.template(float)
+    )
+    return [
+        "{",
+        f"const optional<float> result = ({lambda_})(x);",
+        "if (!result.has_value())",
+        "return {};",
+        "x = *result;",
+        "}",
+    ]
+
+
+async def build_fused_filter(configs):
+    statements = []
+    for conf in configs:
+        registry_entry, config = cg.extract_registry_entry_config(FILTER_REGISTRY, conf)
+        statements += await FUSABLE_FILTERS[registry_entry.name](config)
+    body = "\n".join(statements)
+    func = cg.RawExpression(
+        f"[=](float x) -> optional<float> {{\n{body}\nreturn x;\n}}"
+    )
+    # takes the place of the first filter, the generated IDs of the others stay unused
+    filter_id = configs[0][CONF_TYPE_ID].copy()
+    return cg.Pvariable(filter_id, make_fused_filter(func), Filter)
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    filters = []
+    fusable = []
+
+    async def flush_fusable():
+        if len(fusable) == 1:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, fusable[0]))
+        elif fusable:
+            filters.append(await build_fused_filter(fusable))
+        fusable.clear()
+
+    for conf in config:
+        registry_entry, _ = cg.extract_registry_entry_config(FILTER_REGISTRY, conf)
+        # A filter with an ID set by the user can be looked up with its own type, so
+        # it always stays a filter of its own.
+        if registry_entry.name in FUSABLE_FILTERS and not conf[CONF_TYPE_ID].is_manual:
+            fusable.append(conf)
+            continue
+        await flush_fusable()
+        filters.append(await cg.build_registry_entry(FILTER_REGISTRY, conf))
+    await flush_fusable()
+    return filters
 
 
 async def setup_sensor_core_(var, config):
@@ -742,6 +901,18 @@ async def setup_sensor_core_(var, config):
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = await build_filters(config[CONF_FILTERS])
         cg.add(var.set_filters(filters))
+    if history_config := config.get(CONF_HISTORY):
+        cg.add_define("USE_SENSOR_HISTORY")
+        history = cg.new_Pvariable(
+            history_config[CONF_ID],
+            var,
+            history_config[CONF_RAW_SIZE],
+            history_config[CONF_MINUTE_SIZE],
+            history_config[CONF_HOUR_SIZE],
+        )
+        if CONF_RESOLUTION in history_config:
+            cg.add(history.set_resolution(history_config[CONF_RESOLUTION]))
+        cg.add(var.set_history(history))
 
     for conf in config.get(CONF_ON_VALUE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
@@ -5,6 +5,7 @@
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "sliding_window_quantile.h"
 
 namespace esphome {
 namespace sensor {
@@ -29,10 +30,24 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** This will be called when the filter receives a batch of values.
+   *
+   * The values are filtered in place: the ones that should be passed down the chain are written to the start of
+   * `values`, in order. The default implementation calls new_value() for each value, filters that can do better
+   * override it with a tight loop.
+   *
+   * @param values The new values, oldest first. Overwritten with the values to push out.
+   * @param count The number of values.
+   * @return The number of values that should be pushed out, at most `count`.
+   */
+  virtual size_t new_values(float *values, size_t count);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
   void input(float value);
+  /// Pass a batch of values through this filter and the rest of the chain, `values` is used as scratch space.
+  void input_values(float *values, size_t count);
 
   void output(float value);
 
@@ -67,11 +82,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
-  float quantile_;
 };
 
 /** Simple median filter.
@@ -96,10 +109,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple skip filter.
@@ -142,10 +154,9 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -170,10 +181,9 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -194,15 +204,26 @@ class SlidingWindowMovingAverageFilter : public Filter {
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  /// Add a value to or remove it from the running sum and counts.
+  void update_sum_(float value, bool add);
+
+  FixedRingBuffer<float> queue_;
+  /// Running sum of the finite values in queue_ and count of the non-NaN ones. Infinite values are only counted, so
+  /// that the sum is still valid once they leave the window.
+  float sum_{0.0f};
+  size_t valid_count_{0};
+  size_t pos_inf_count_{0};
+  size_t neg_inf_count_{0};
+  /// Values pushed since sum_ was last recomputed from scratch, which keeps rounding errors from adding up.
+  size_t pushes_since_sum_{0};
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -215,6 +236,7 @@ class ExponentialMovingAverageFilter : public Filter {
   ExponentialMovingAverageFilter(float alpha, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
   void set_send_every(size_t send_every);
   void set_alpha(float alpha);
@@ -275,6 +297,7 @@ class OffsetFilter : public Filter {
   explicit OffsetFilter(float offset);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float offset_;
@@ -286,6 +309,7 @@ class MultiplyFilter : public Filter {
   explicit MultiplyFilter(float multiplier);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float multiplier_;
@@ -395,6 +419,7 @@ class CalibrateLinearFilter : public Filter {
   CalibrateLinearFilter(std::vector<std::array<float, 3>> linear_functions)
       : linear_functions_(std::move(linear_functions)) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<std::array<float, 3>> linear_functions_;
@@ -404,6 +429,7 @@ class CalibratePolynomialFilter : public Filter {
  public:
   CalibratePolynomialFilter(std::vector<float> coefficients) : coefficients_(std::move(coefficients)) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<float> coefficients_;
@@ -413,6 +439,7 @@ class ClampFilter : public Filter {
  public:
   ClampFilter(float min, float max, bool ignore_out_of_range);
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float min_{NAN};
@@ -429,5 +456,35 @@ class RoundFilter : public Filter {
   uint8_t precision_;
 };
 
+/** A run of stateless filters (offset, multiply, calibrate_linear, calibrate_polynomial, clamp, round and lambda) that
+ * the code generator fused into one filter.
+ *
+ * `F` is a lambda taking the value and returning an `optional<float>` that applies all of them, so that the value
+ * passes the whole run with one virtual call and the compiler can inline the steps into each other.
+ */
+template<typename F> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(F func) : func_(std::move(func)) {}
+
+  optional<float> new_value(float value) override { return this->func_(value); }
+  size_t new_values(float *values, size_t count) override {
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++) {
+      optional<float> value = this->func_(values[i]);
+      if (value.has_value())
+        values[out++] = *value;
+    }
+    return out;
+  }
+
+ protected:
+  F func_;
+};
+
+/// Create a FusedFilter, which lets the code generator pass a lambda without naming its type.
+template<typename F> Filter *make_fused_filter(F func) {
+  return new FusedFilter<F>(std::move(func));  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
 }  // namespace sensor
 }  // namespace esphome
@@ -49,9 +49,22 @@ void Sensor::publish_state(float state) {
   }
 }
 
-void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
-void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
-  this->raw_callback_.add(std::move(callback));
+void Sensor::publish_states(float *states, size_t count) {
+  if (count == 0)
+    return;
+  for (size_t i = 0; i < count; i++) {
+    this->raw_state = states[i];
+    this->raw_callback_.call(states[i]);
+  }
+
+  ESP_LOGV(TAG, "'%s': Received %u new states", this->name_.c_str(), (unsigned) count);
+
+  if (this->filter_list_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->internal_send_state_to_frontend(states[i]);
+  } else {
+    this->filter_list_->input_values(states, count);
+  }
 }
 
 void Sensor::add_filter(Filter *filter) {
@@ -92,6 +105,10 @@ void Sensor::internal_send_state_to_frontend(float state) {
   this->state = state;
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
            this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
+#ifdef USE_SENSOR_HISTORY
+  if (this->history_ != nullptr)
+    this->history_->add(state);
+#endif
   this->callback_.call(state);
 }
 bool Sensor::has_state() const { return this->has_state_; }
@@ -5,6 +5,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/sensor_history.h"
 
 #include <vector>
 
@@ -114,12 +115,25 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
    */
   void publish_state(float state);
 
+  /** Publish a batch of new states, as if publish_state() was called for each of them.
+   *
+   * The raw state callbacks are called for every state first, then the whole batch is passed through the filters at
+   * once, which lets filters like offset, multiply or the moving averages process it in one loop. Only the states
+   * that come out of the filter chain are sent to the front-end.
+   *
+   * @param states The states, oldest first. The filters work in place, so these are overwritten.
+   * @param count The number of states.
+   */
+  void publish_states(float *states, size_t count);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
-  void add_on_state_callback(std::function<void(float)> &&callback);
+  template<typename F> void add_on_state_callback(F &&callback) { this->callback_.add(std::forward<F>(callback)); }
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(float)> &&callback);
+  template<typename F> void add_on_raw_state_callback(F &&callback) {
+    this->raw_callback_.add(std::forward<F>(callback));
+  }
 
   /** This member variable stores the last state that has passed through all filters.
    *
@@ -147,11 +161,21 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
 
   void internal_send_state_to_frontend(float state);
 
+#ifdef USE_SENSOR_HISTORY
+  /// Keep the states this sensor publishes in `history`.
+  void set_history(SensorHistory *history) { this->history_ = history; }
+  /// The history of this sensor, nullptr if it doesn't keep one.
+  SensorHistory *get_history() const { return this->history_; }
+#endif
+
  protected:
   CallbackManager<void(float)> raw_callback_;  ///< Storage for raw state callbacks.
   CallbackManager<void(float)> callback_;      ///< Storage for filtered state callbacks.
 
   Filter *filter_list_{nullptr};  ///< Store all active filters.
+#ifdef USE_SENSOR_HISTORY
+  SensorHistory *history_{nullptr};
+#endif
 
   optional<int8_t> accuracy_decimals_;                  ///< Accuracy in decimals override
   optional<StateClass> state_class_{STATE_CLASS_NONE};  ///< State class override
@@ -0,0 +1,204 @@
+#include "sensor_history.h"
+
+#ifdef USE_SENSOR_HISTORY
+
+#include <algorithm>
+#include <cmath>
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "sensor.h"
+
+namespace esphome {
+namespace sensor {
+
+static const char *const TAG = "sensor.history";
+
+static const uint32_t MAX_DELTA = UINT16_MAX;
+
+SensorHistory::SensorHistory(Sensor *parent, size_t raw_size, size_t minute_size, size_t hour_size)
+    : parent_(parent) {
+  // a history that doesn't fit leaves the ring empty instead of aborting
+  this->raw_ = RawRing(raw_size, RawAllocator(RawAllocator::ALLOW_FAILURE));
+  this->levels_[0].ring = AggregateRing(minute_size, AggregateAllocator(AggregateAllocator::ALLOW_FAILURE));
+  this->levels_[0].interval_ms = 60 * 1000;
+  this->levels_[1].ring = AggregateRing(hour_size, AggregateAllocator(AggregateAllocator::ALLOW_FAILURE));
+  this->levels_[1].interval_ms = 60 * 60 * 1000;
+  if (this->raw_.capacity() != raw_size || this->levels_[0].ring.capacity() != minute_size ||
+      this->levels_[1].ring.capacity() != hour_size) {
+    ESP_LOGE(TAG, "'%s': Not enough memory for the history", parent->get_name().c_str());
+  }
+}
+
+int16_t SensorHistory::quantize_(float value) {
+  if (!std::isfinite(value))
+    return NAN_VALUE;
+  if (std::isnan(this->offset_))
+    this->offset_ = roundf(value / this->resolution_) * this->resolution_;
+  float steps = roundf((value - this->offset_) / this->resolution_);
+  while (steps < NAN_VALUE + 1 || steps > INT16_MAX) {
+    this->coarsen_();
+    steps = roundf((value - this->offset_) / this->resolution_);
+  }
+  return static_cast<int16_t>(steps);
+}
+
+float SensorHistory::dequantize_(int16_t value) const {
+  if (value == NAN_VALUE)
+    return NAN;
+  return this->offset_ + value * this->resolution_;
+}
+
+void SensorHistory::coarsen_() {
+  auto halve = [](int16_t &value) {
+    if (value != GAP && value != NAN_VALUE)
+      value = static_cast<int16_t>(lroundf(value / 2.0f));
+  };
+  this->resolution_ *= 2.0f;
+  for (size_t i = 0; i < this->raw_.size(); i++)
+    halve(this->raw_[i].value);
+  for (auto &level : this->levels_) {
+    for (size_t i = 0; i < level.ring.size(); i++) {
+      AggregateRecord &record = level.ring[i];
+      halve(record.mean);
+      halve(record.min);
+      halve(record.max);
+    }
+  }
+  ESP_LOGW(TAG, "'%s': State out of the history's range, its resolution is now %g", this->parent_->get_name().c_str(),
+           this->resolution_);
+}
+
+void SensorHistory::add(float value) {
+  if (std::isnan(this->resolution_))
+    this->resolution_ = powf(10.0f, -this->parent_->get_accuracy_decimals());
+  const uint32_t now = millis();
+
+  if (this->raw_.capacity() != 0) {
+    if (this->raw_.empty()) {
+      this->raw_newest_ms_ = now;
+      this->raw_.push(RawRecord{0, this->quantize_(value)});
+    } else {
+      uint32_t delta = (now - this->raw_newest_ms_) / RAW_TICK_MS;
+      this->raw_newest_ms_ += delta * RAW_TICK_MS;
+      for (; delta > MAX_DELTA; delta -= MAX_DELTA)
+        this->raw_.push(RawRecord{MAX_DELTA, GAP});
+      this->raw_.push(RawRecord{static_cast<uint16_t>(delta), this->quantize_(value)});
+    }
+  }
+
+  for (auto &level : this->levels_)
+    this->add_aggregate_(level, now, value);
+}
+
+void SensorHistory::add_aggregate_(AggregateLevel &level, uint32_t now, float value) {
+  if (level.ring.capacity() == 0)
+    return;
+  if (!level.started) {
+    level.started = true;
+    level.start_ms = now - now % level.interval_ms;
+  }
+
+  const uint32_t intervals = (now - level.start_ms) / level.interval_ms;
+  if (intervals != 0) {
+    // the value starts a new interval, store the aggregate of the finished one
+    AggregateRecord record{0, NAN_VALUE, NAN_VALUE, NAN_VALUE};
+    if (level.count != 0) {
+      record.mean = this->quantize_(level.sum / level.count);
+      record.min = this->quantize_(level.min);
+      record.max = this->quantize_(level.max);
+    }
+    if (!level.ring.empty()) {
+      uint32_t delta = (level.start_ms - level.newest_ms) / level.interval_ms;
+      for (; delta > MAX_DELTA; delta -= MAX_DELTA)
+        level.ring.push(AggregateRecord{MAX_DELTA, GAP, GAP, GAP});
+      record.delta = static_cast<uint16_t>(delta);
+    }
+    level.ring.push(record);
+    level.newest_ms = level.start_ms;
+
+    level.start_ms += intervals * level.interval_ms;
+    level.sum = 0.0f;
+    level.count = 0;
+    level.min = level.max = NAN;
+  }
+
+  if (std::isnan(value) || level.count == UINT16_MAX)
+    return;
+  level.sum += value;
+  level.count++;
+  if (level.count == 1 || value < level.min)
+    level.min = value;
+  if (level.count == 1 || value > level.max)
+    level.max = value;
+}
+
+std::vector<SensorHistoryPoint> SensorHistory::query(SensorHistoryResolution resolution, uint32_t max_age_ms) const {
+  std::vector<SensorHistoryPoint> points;
+  const uint32_t now = millis();
+  if (resolution != SENSOR_HISTORY_RAW) {
+    this->query_aggregates_(this->levels_[resolution == SENSOR_HISTORY_MINUTE ? 0 : 1], now, max_age_ms, points);
+    return points;
+  }
+
+  // walk back from the newest record, whose time is known
+  uint32_t age = now - this->raw_newest_ms_;
+  for (size_t i = this->raw_.size(); i-- > 0;) {
+    const RawRecord &record = this->raw_[i];
+    if (max_age_ms != 0 && age > max_age_ms)
+      break;
+    if (record.value != GAP) {
+      const float value = this->dequantize_(record.value);
+      points.push_back(SensorHistoryPoint{age, value, value, value});
+    }
+    const uint32_t older = age + record.delta * RAW_TICK_MS;
+    if (older < age)
+      break;  // beyond what millis() covers
+    age = older;
+  }
+  std::reverse(points.begin(), points.end());
+  return points;
+}
+
+void SensorHistory::query_aggregates_(const AggregateLevel &level, uint32_t now, uint32_t max_age_ms,
+                                      std::vector<SensorHistoryPoint> &points) const {
+  if (!level.started)
+    return;
+  // the interval that is still being aggregated comes last, so it's added first
+  if (max_age_ms == 0 || now - level.start_ms <= max_age_ms) {
+    points.push_back(SensorHistoryPoint{now - level.start_ms, level.count == 0 ? NAN : level.sum / level.count,
+                                        level.min, level.max});
+  }
+
+  uint32_t age = now - level.newest_ms;
+  for (size_t i = level.ring.size(); i-- > 0;) {
+    const AggregateRecord &record = level.ring[i];
+    if (max_age_ms != 0 && age > max_age_ms)
+      break;
+    if (record.mean != GAP) {
+      points.push_back(SensorHistoryPoint{age, this->dequantize_(record.mean), this->dequantize_(record.min),
+                                          this->dequantize_(record.max)});
+    }
+    const uint32_t older = age + record.delta * level.interval_ms;
+    if (older < age)
+      break;
+    age = older;
+  }
+  std::reverse(points.begin(), points.end());
+}
+
+size_t SensorHistory::get_size(SensorHistoryResolution resolution) const {
+  switch (resolution) {
+    case SENSOR_HISTORY_RAW:
+      return this->raw_.size();
+    case SENSOR_HISTORY_MINUTE:
+      return this->levels_[0].ring.size();
+    case SENSOR_HISTORY_HOUR:
+      return this->levels_[1].ring.size();
+  }
+  return 0;
+}
+
+}  // namespace sensor
+}  // namespace esphome
+
+#endif  // USE_SENSOR_HISTORY
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SENSOR_HISTORY
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace sensor {
+
+class Sensor;
+
+/// The levels of detail a SensorHistory keeps.
+enum SensorHistoryResolution : uint8_t {
+  SENSOR_HISTORY_RAW = 0,     ///< Every published state.
+  SENSOR_HISTORY_MINUTE = 1,  ///< Mean, minimum and maximum per minute.
+  SENSOR_HISTORY_HOUR = 2,    ///< Mean, minimum and maximum per hour.
+};
+
+/// A state, or the aggregate of an interval, from a SensorHistory.
+struct SensorHistoryPoint {
+  /// Milliseconds from the point (the start of its interval for aggregates) to the query.
+  uint32_t age_ms;
+  /// The state for raw points.
+  float mean;
+  float min;
+  float max;
+};
+
+/** Recent states of a sensor, kept on the device so that clients can fill gaps in their own history.
+ *
+ * Every published state goes into a ring of raw records, and is aggregated into rings of one-minute and one-hour
+ * records that reach further back. Records store the time since the previous record in 16 bits and their values
+ * quantized to 16 bits in steps of the resolution, relative to the first state, so a raw record takes 4 bytes and an
+ * aggregate 8 bytes. The rings are allocated in PSRAM if there is any.
+ *
+ * Intervals are aligned to the uptime rather than the wall clock, and points older than the 49 days millis() covers
+ * aren't reported.
+ */
+class SensorHistory {
+ public:
+  SensorHistory(Sensor *parent, size_t raw_size, size_t minute_size, size_t hour_size);
+
+  /** Set the step between quantized values.
+   *
+   * Defaults to the accuracy of the sensor, e.g. 0.01 for 2 accuracy decimals. Values are stored as steps from the
+   * first state, and once a state is more than 32766 steps away the step doubles (and the stored records are
+   * converted) until it fits, so the history loses precision rather than clamping states.
+   */
+  void set_resolution(float resolution) { this->resolution_ = resolution; }
+
+  /// Called by the sensor with every state it publishes.
+  void add(float value);
+
+  /// The points of `resolution` that are at most `max_age_ms` old (0 for all of them), oldest first. The minute and
+  /// hour points end with the interval that is still being aggregated.
+  std::vector<SensorHistoryPoint> query(SensorHistoryResolution resolution, uint32_t max_age_ms) const;
+
+  size_t get_size(SensorHistoryResolution resolution) const;
+  Sensor *get_parent() const { return this->parent_; }
+
+ protected:
+  /// Unit of the time delta of raw records.
+  static const uint32_t RAW_TICK_MS = 100;
+  /// Value of records that only carry time, when the delta to the previous record doesn't fit into 16 bits.
+  static const int16_t GAP = INT16_MIN;
+  /// Value of NaN and infinite states, and of aggregates of intervals without a valid state.
+  static const int16_t NAN_VALUE = INT16_MIN + 1;
+
+  struct RawRecord {
+    /// Time since the previous record, in RAW_TICK_MS.
+    uint16_t delta;
+    int16_t value;
+  };
+  struct AggregateRecord {
+    /// Intervals since the previous record.
+    uint16_t delta;
+    int16_t mean;
+    int16_t min;
+    int16_t max;
+  };
+  using RawAllocator = ExternalRAMAllocator<RawRecord>;
+  using AggregateAllocator = ExternalRAMAllocator<AggregateRecord>;
+  using RawRing = FixedRingBuffer<RawRecord, RawAllocator>;
+  using AggregateRing = FixedRingBuffer<AggregateRecord, AggregateAllocator>;
+
+  /// The one-minute or one-hour aggregates.
+  struct AggregateLevel {
+    AggregateRing ring;
+    uint32_t interval_ms;
+    /// Start of the interval that is being aggregated, and of the one of the newest record.
+    uint32_t start_ms{0};
+    uint32_t newest_ms{0};
+    float sum{0.0f};
+    float min{NAN};
+    float max{NAN};
+    uint16_t count{0};
+    bool started{false};
+  };
+
+  int16_t quantize_(float value);
+  float dequantize_(int16_t value) const;
+  /// Double the step between quantized values and convert the stored records to it.
+  void coarsen_();
+  void add_aggregate_(AggregateLevel &level, uint32_t now, float value);
+  void query_aggregates_(const AggregateLevel &level, uint32_t now, uint32_t max_age_ms,
+                         std::vector<SensorHistoryPoint> &points) const;
+
+  Sensor *parent_;
+  float resolution_{NAN};
+  /// The value quantized to 0, the first state rounded to the resolution.
+  float offset_{NAN};
+  RawRing raw_;
+  /// Time of the newest raw record, rounded to RAW_TICK_MS steps since the first one.
+  uint32_t raw_newest_ms_{0};
+  AggregateLevel levels_[2];
+};
+
+}  // namespace sensor
+}  // namespace esphome
+
+#endif  // USE_SENSOR_HISTORY
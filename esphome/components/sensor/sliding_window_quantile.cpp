@@ -0,0 +1,154 @@
+#include "sliding_window_quantile.h"
+#include <algorithm>
+#include <cmath>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace sensor {
+
+SlidingWindowQuantile::SlidingWindowQuantile(size_t window_size, float quantile) : quantile_(quantile) {
+  this->set_window_size(window_size);
+}
+
+void SlidingWindowQuantile::set_window_size(size_t window_size) {
+  if (window_size > MAX_WINDOW_SIZE)
+    window_size = MAX_WINDOW_SIZE;
+  if (window_size == 0)
+    window_size = 1;
+  if (window_size == this->capacity_)
+    return;
+
+  // replay the newest values into the new buffers
+  FixedRingBuffer<float> old_values = std::move(this->values_);
+  this->capacity_ = window_size;
+  this->values_.init(window_size);
+  this->pos_.reset(new uint16_t[window_size]);   // NOLINT(modernize-avoid-c-arrays)
+  this->heap_.reset(new uint16_t[window_size]);  // NOLINT(modernize-avoid-c-arrays)
+  this->heap_size_[LOWER] = this->heap_size_[UPPER] = 0;
+  for (size_t i = old_values.size() - std::min(old_values.size(), window_size); i < old_values.size(); i++)
+    this->push(old_values[i]);
+}
+
+void SlidingWindowQuantile::set_quantile(float quantile) {
+  this->quantile_ = quantile;
+  this->rebalance_();
+}
+
+void SlidingWindowQuantile::push(float value) {
+  const bool full = this->values_.full();
+  const uint16_t slot = this->values_.push(value);
+  if (full) {
+    // the new value took the slot of the oldest one, which is still in its heap
+    this->remove_(slot);
+  }
+
+  if (std::isnan(value)) {
+    this->pos_[slot] = NOT_IN_HEAP;
+  } else {
+    const float *values = this->values_.data();
+    // every value in the lower heap must be less than or equal to every value in the upper heap
+    bool lower;
+    if (this->heap_size_[LOWER] != 0) {
+      lower = value <= values[this->top_(LOWER)];
+    } else {
+      lower = this->heap_size_[UPPER] == 0 || value <= values[this->top_(UPPER)];
+    }
+    this->heap_push_(lower ? LOWER : UPPER, slot);
+  }
+  this->rebalance_();
+}
+
+float SlidingWindowQuantile::get() const {
+  if (this->heap_size_[LOWER] == 0)
+    return NAN;
+  return this->values_.data()[this->top_(LOWER)];
+}
+
+float SlidingWindowQuantile::get_next() const {
+  if (this->heap_size_[UPPER] == 0)
+    return NAN;
+  return this->values_.data()[this->top_(UPPER)];
+}
+
+void SlidingWindowQuantile::rebalance_() {
+  const size_t size = this->size();
+  // same rank as picking index ceil(size * quantile) - 1 from the sorted values
+  size_t target = size == 0 ? 0 : clamp<size_t>(ceilf(size * this->quantile_), 1, size);
+  while (this->heap_size_[LOWER] > target) {
+    const uint16_t slot = this->top_(LOWER);
+    this->heap_remove_(LOWER, 0);
+    this->heap_push_(UPPER, slot);
+  }
+  while (this->heap_size_[LOWER] < target) {
+    const uint16_t slot = this->top_(UPPER);
+    this->heap_remove_(UPPER, 0);
+    this->heap_push_(LOWER, slot);
+  }
+}
+
+void SlidingWindowQuantile::remove_(uint16_t slot) {
+  const uint16_t pos = this->pos_[slot];
+  if (pos == NOT_IN_HEAP)
+    return;
+  if (pos & UPPER_FLAG) {
+    this->heap_remove_(UPPER, pos & ~UPPER_FLAG);
+  } else {
+    this->heap_remove_(LOWER, pos);
+  }
+}
+
+void SlidingWindowQuantile::place_(Heap heap, uint16_t index, uint16_t slot) {
+  this->heap_at_(heap, index) = slot;
+  this->pos_[slot] = heap == UPPER ? index | UPPER_FLAG : index;
+}
+
+void SlidingWindowQuantile::sift_up_(Heap heap, uint16_t index) {
+  const uint16_t slot = this->heap_at_(heap, index);
+  while (index > 0) {
+    const uint16_t parent = (index - 1) / 2;
+    const uint16_t parent_slot = this->heap_at_(heap, parent);
+    if (!this->above_(heap, slot, parent_slot))
+      break;
+    this->place_(heap, index, parent_slot);
+    index = parent;
+  }
+  this->place_(heap, index, slot);
+}
+
+void SlidingWindowQuantile::sift_down_(Heap heap, uint16_t index) {
+  const uint16_t size = this->heap_size_[heap];
+  const uint16_t slot = this->heap_at_(heap, index);
+  while (true) {
+    uint16_t child = 2 * index + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->above_(heap, this->heap_at_(heap, child + 1), this->heap_at_(heap, child)))
+      child++;
+    const uint16_t child_slot = this->heap_at_(heap, child);
+    if (!this->above_(heap, child_slot, slot))
+      break;
+    this->place_(heap, index, child_slot);
+    index = child;
+  }
+  this->place_(heap, index, slot);
+}
+
+void SlidingWindowQuantile::heap_push_(Heap heap, uint16_t slot) {
+  const uint16_t index = this->heap_size_[heap]++;
+  this->place_(heap, index, slot);
+  this->sift_up_(heap, index);
+}
+
+void SlidingWindowQuantile::heap_remove_(Heap heap, uint16_t index) {
+  const uint16_t last = --this->heap_size_[heap];
+  if (index == last)
+    return;
+  const uint16_t slot = this->heap_at_(heap, last);
+  this->place_(heap, index, slot);
+  // the moved value can belong above or below its new position
+  this->sift_up_(heap, index);
+  this->sift_down_(heap, this->pos_[slot] & ~UPPER_FLAG);
+}
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace sensor {
+
+/** Quantile of the last `window_size` values, updated in O(log n) per value.
+ *
+ * The values are kept in a FixedRingBuffer. The non-NaN values in it are additionally split into
+ * two binary heaps of ring positions: a max-heap with the k smallest values and a min-heap with all others, where k
+ * follows from the quantile. The quantile is the top of the max-heap; when a value leaves the window, its slot knows
+ * its heap position so it can be removed directly.
+ *
+ * A quantile of 0 gives the minimum and 1 the maximum, 0.5 splits the values in half for the median.
+ */
+class SlidingWindowQuantile {
+ public:
+  /// `window_size` must not exceed MAX_WINDOW_SIZE.
+  SlidingWindowQuantile(size_t window_size, float quantile);
+
+  static const size_t MAX_WINDOW_SIZE = 32767;
+
+  /// Add a value and drop the oldest one if the window is full. NaN values take up room but are otherwise ignored.
+  void push(float value);
+
+  /// Number of non-NaN values in the window.
+  size_t size() const { return this->heap_size_[LOWER] + this->heap_size_[UPPER]; }
+  /// The ceil(size() * quantile)-th smallest value (at least the smallest), NaN if size() is 0.
+  float get() const;
+  /// The value after get() in sorted order, NaN if there is none.
+  float get_next() const;
+
+  /// Change the window size, the newest values are kept.
+  void set_window_size(size_t window_size);
+  void set_quantile(float quantile);
+
+ protected:
+  enum Heap : uint8_t { LOWER = 0, UPPER = 1 };
+  /// Heap position of a slot that holds NaN.
+  static const uint16_t NOT_IN_HEAP = 0xFFFF;
+  /// Set in the heap position of slots in the upper heap.
+  static const uint16_t UPPER_FLAG = 0x8000;
+
+  /// Both heaps share one array: the lower heap grows from the front, the upper heap from the back.
+  uint16_t &heap_at_(Heap heap, uint16_t index) {
+    return heap == LOWER ? this->heap_[index] : this->heap_[this->capacity_ - 1 - index];
+  }
+  uint16_t top_(Heap heap) const { return heap == LOWER ? this->heap_[0] : this->heap_[this->capacity_ - 1]; }
+  /// Whether slot `a` belongs above slot `b` in the heap.
+  bool above_(Heap heap, uint16_t a, uint16_t b) const {
+    const float *values = this->values_.data();
+    return heap == LOWER ? values[a] > values[b] : values[a] < values[b];
+  }
+  void place_(Heap heap, uint16_t index, uint16_t slot);
+  void sift_up_(Heap heap, uint16_t index);
+  void sift_down_(Heap heap, uint16_t index);
+  void heap_push_(Heap heap, uint16_t slot);
+  void heap_remove_(Heap heap, uint16_t index);
+  /// Remove the value in `slot` from its heap.
+  void remove_(uint16_t slot);
+  /// Move values between the heaps until the lower heap holds as many as the quantile asks for.
+  void rebalance_();
+
+  /// Heaps refer to values by their slot, their index in values_.data().
+  FixedRingBuffer<float> values_;
+  std::unique_ptr<uint16_t[]> pos_;   // NOLINT(modernize-avoid-c-arrays)
+  std::unique_ptr<uint16_t[]> heap_;  // NOLINT(modernize-avoid-c-arrays)
+  uint16_t capacity_{0};
+  uint16_t heap_size_[2]{0, 0};
+  float quantile_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -154,6 +154,7 @@ using socklen_t = uint32_t;
 #include <cstdint>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
@@ -3,7 +3,14 @@
 #include "esphome/core/component.h"
 #include "esphome/core/component_iterator.h"
 #include "esphome/core/defines.h"
+#include <string>
+
 namespace esphome {
+#ifdef USE_ESP_IDF
+namespace web_server_idf {
+class AsyncEventSourceResponse;
+}  // namespace web_server_idf
+#endif
 namespace web_server {
 
 class WebServer;
@@ -11,6 +18,12 @@ class WebServer;
 class ListEntitiesIterator : public ComponentIterator {
  public:
   ListEntitiesIterator(WebServer *web_server);
+#ifdef USE_ESP_IDF
+  /// Send the states to this client only instead of to all of them.
+  void set_client(web_server_idf::AsyncEventSourceResponse *client) { this->client_ = client; }
+#endif
+  /// Whether the iterator went through all entities, or wasn't started.
+  bool completed() const { return this->state_ == IteratorState::NONE; }
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
@@ -55,7 +68,12 @@ class ListEntitiesIterator : public ComponentIterator {
 #endif
 
  protected:
+  void send_(const std::string &json);
+
   WebServer *web_server_;
+#ifdef USE_ESP_IDF
+  web_server_idf::AsyncEventSourceResponse *client_{nullptr};
+#endif
 };
 
 }  // namespace web_server
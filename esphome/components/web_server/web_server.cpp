@@ -1,6 +1,7 @@
 #include "web_server.h"
 
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
@@ -11,6 +12,8 @@
 #include "StreamString.h"
 #endif
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstdlib>
 
 #ifdef USE_LIGHT
@@ -25,6 +28,10 @@
 #include "esphome/components/climate/climate.h"
 #endif
 
+#ifdef USE_PROFILER
+#include "esphome/components/profiler/profiler.h"
+#endif
+
 #ifdef USE_WEBSERVER_LOCAL
 #include "server_index.h"
 #endif
@@ -34,6 +41,9 @@ namespace web_server {
 
 static const char *const TAG = "web_server";
 
+static const char *const HEADER_ETAG = "ETag";
+static const char *const HEADER_IF_NONE_MATCH = "If-None-Match";
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
 static const char *const HEADER_PNA_NAME = "Private-Network-Access-Name";
 static const char *const HEADER_PNA_ID = "Private-Network-Access-ID";
@@ -110,17 +120,18 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
-    root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
-    root["comment"] = App.get_comment();
-    root["ota"] = this->allow_ota_;
-    root["log"] = this->expose_log_;
-    root["lang"] = "en";
+  return json::write_json([this](json::JsonObjectWriter root) {
+    root.add("title", App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name());
+    root.add("comment", App.get_comment());
+    root.add("ota", this->allow_ota_);
+    root.add("log", this->expose_log_);
+    root.add("lang", "en");
   });
 }
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
+  this->boot_id_ = random_uint32();
   this->setup_controller(this->include_internal_);
   this->base_->init();
 
@@ -130,11 +141,17 @@ void WebServer::setup() {
 
     this->entities_iterator_.begin(this->include_internal_);
   });
+#ifdef USE_ESP_IDF
+  this->events_.set_on_resync([this](AsyncEventSourceClient *client) {
+    if (std::find(this->resync_clients_.begin(), this->resync_clients_.end(), client) == this->resync_clients_.end())
+      this->resync_clients_.push_back(client);
+  });
+#endif
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr && this->expose_log_) {
     logger::global_logger->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+        [this](int level, const char *tag, const char *message) { this->defer_log_event_(message); });
   }
 #endif
   this->base_->add_handler(&this->events_);
@@ -163,6 +180,292 @@ void WebServer::loop() {
   }
 #endif
   this->entities_iterator_.advance();
+#ifdef USE_ESP_IDF
+  if (this->resync_iterator_.completed() && !this->resync_clients_.empty()) {
+    this->resync_iterator_.set_client(this->resync_clients_.front());
+    this->resync_clients_.pop_front();
+    this->resync_iterator_.begin(this->include_internal_);
+  }
+  this->resync_iterator_.advance();
+#endif
+  this->flush_events_();
+}
+void WebServer::on_state_change_(EntityBase *source, EntityType type) {
+  {
+    LockGuard guard{this->rendered_states_lock_};
+    this->state_version_++;
+    auto it = this->rendered_states_.find(source);
+    if (it != this->rendered_states_.end()) {
+      it->second.version = this->state_version_;
+      it->second.json.clear();
+    }
+  }
+
+  if (this->events_.count() == 0)
+    return;
+  for (const auto &event : this->deferred_states_) {
+    // the queued event is built from the state at the time it's sent, it covers this update
+    if (event.source == source)
+      return;
+  }
+  this->deferred_states_.push_back(DeferredStateEvent{source, type});
+}
+#ifdef USE_LOGGER
+void WebServer::defer_log_event_(const char *message) {
+  if (this->events_.count() == 0)
+    return;
+  if (this->deferred_logs_.size() == MAX_DEFERRED_LOG_LINES) {
+    // keep the latest lines, the clients are told how many are missing
+    this->deferred_logs_.pop_front();
+    this->dropped_log_lines_++;
+  }
+  this->deferred_logs_.emplace_back(message);
+}
+#endif
+void WebServer::flush_events_() {
+#ifdef USE_ARDUINO
+  // Clients that fall behind hold everyone's events back: in the meantime the states of an entity collapse into the
+  // latest one and only the latest log lines are kept.
+  if (this->events_.count() != 0 && this->events_.avgPacketsWaiting() >= MAX_PACKETS_WAITING)
+    return;
+#endif
+#ifdef USE_LOGGER
+  if (this->dropped_log_lines_ != 0) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "[W][web_server]: %" PRIu32 " log lines dropped", this->dropped_log_lines_);
+    this->events_.send(buf, "log", millis());
+    this->dropped_log_lines_ = 0;
+  }
+  for (const auto &line : this->deferred_logs_)
+    this->events_.send(line.c_str(), "log", millis());
+  this->deferred_logs_.clear();
+#endif
+  std::string json;
+  for (const auto &event : this->deferred_states_) {
+    json.clear();
+    this->append_state_json_(event.source, event.type, json);
+    this->events_.send(json.c_str(), "state");
+  }
+  this->deferred_states_.clear();
+#ifdef USE_ESP_IDF
+  this->events_.loop();
+#endif
+}
+std::string WebServer::state_json_(EntityBase *source, EntityType type) {
+  switch (type) {
+#ifdef USE_BINARY_SENSOR
+    case ENTITY_TYPE_BINARY_SENSOR: {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(source);
+      return this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_SWITCH
+    case ENTITY_TYPE_SWITCH: {
+      auto *obj = static_cast<switch_::Switch *>(source);
+      return this->switch_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_SENSOR
+    case ENTITY_TYPE_SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(source);
+      return this->sensor_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case ENTITY_TYPE_TEXT_SENSOR: {
+      auto *obj = static_cast<text_sensor::TextSensor *>(source);
+      return this->text_sensor_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_FAN
+    case ENTITY_TYPE_FAN:
+      return this->fan_json(static_cast<fan::Fan *>(source), DETAIL_STATE);
+#endif
+#ifdef USE_COVER
+    case ENTITY_TYPE_COVER:
+      return this->cover_json(static_cast<cover::Cover *>(source), DETAIL_STATE);
+#endif
+#ifdef USE_LIGHT
+    case ENTITY_TYPE_LIGHT:
+      return this->light_json(static_cast<light::LightState *>(source), DETAIL_STATE);
+#endif
+#ifdef USE_CLIMATE
+    case ENTITY_TYPE_CLIMATE:
+      return this->climate_json(static_cast<climate::Climate *>(source), DETAIL_STATE);
+#endif
+#ifdef USE_NUMBER
+    case ENTITY_TYPE_NUMBER: {
+      auto *obj = static_cast<number::Number *>(source);
+      return this->number_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_TEXT
+    case ENTITY_TYPE_TEXT: {
+      auto *obj = static_cast<text::Text *>(source);
+      return this->text_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_SELECT
+    case ENTITY_TYPE_SELECT: {
+      auto *obj = static_cast<select::Select *>(source);
+      return this->select_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_LOCK
+    case ENTITY_TYPE_LOCK: {
+      auto *obj = static_cast<lock::Lock *>(source);
+      return this->lock_json(obj, obj->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+    case ENTITY_TYPE_ALARM_CONTROL_PANEL: {
+      auto *obj = static_cast<alarm_control_panel::AlarmControlPanel *>(source);
+      return this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
+    }
+#endif
+    default:
+      return "";
+  }
+}
+uint32_t WebServer::append_state_json_(EntityBase *source, EntityType type, std::string &out) {
+  LockGuard guard{this->rendered_states_lock_};
+  auto it = this->rendered_states_.find(source);
+  if (it == this->rendered_states_.end())
+    it = this->rendered_states_.emplace(source, RenderedState{this->state_version_, {}}).first;
+  if (it->second.json.empty())
+    it->second.json = this->state_json_(source, type);
+  out.append(it->second.json);
+  return it->second.version;
+}
+std::string WebServer::etag_(uint32_t version) const {
+  // the boot ID keeps ETags from before a restart from matching
+  return str_sprintf("\"%08" PRIx32 "-%" PRIx32 "\"", this->boot_id_, version);
+}
+std::string WebServer::index_etag_() const {
+  // the page only changes with a new firmware
+  return str_sprintf("\"%08" PRIx32 "\"", fnv1_hash(App.get_compilation_time()));
+}
+/// Whether an If-None-Match header value matches the ETag: "*" or a comma-separated list of entity tags, compared
+/// weakly as RFC 9110 asks for this header, so W/"x" matches "x".
+static bool if_none_match_matches(const std::string &header, const std::string &etag) {
+  size_t pos = 0;
+  while (pos < header.size()) {
+    size_t end = header.find(',', pos);
+    if (end == std::string::npos)
+      end = header.size();
+    size_t begin = header.find_first_not_of(" \t", pos);
+    size_t last = header.find_last_not_of(" \t", end - 1);
+    if (begin < end && last != std::string::npos && last >= begin) {
+      if (header.compare(begin, last - begin + 1, "*") == 0)
+        return true;
+      if (header.compare(begin, 2, "W/") == 0)
+        begin += 2;
+      if (header.compare(begin, last - begin + 1, etag) == 0)
+        return true;
+    }
+    pos = end + 1;
+  }
+  return false;
+}
+bool WebServer::send_not_modified_(AsyncWebServerRequest *request, const char *content_type, const std::string &etag) {
+#ifdef USE_ARDUINO
+  AsyncWebHeader *header = request->getHeader(HEADER_IF_NONE_MATCH);
+  if (header == nullptr || !if_none_match_matches(header->value().c_str(), etag))
+    return false;
+#else
+  auto header = request->get_header(HEADER_IF_NONE_MATCH);
+  if (!header.has_value() || !if_none_match_matches(*header, etag))
+    return false;
+#endif
+  AsyncWebServerResponse *response = request->beginResponse(304, content_type, "");
+  response->addHeader(HEADER_ETAG, etag.c_str());
+  request->send(response);
+  return true;
+}
+void WebServer::send_state_(AsyncWebServerRequest *request, EntityBase *source, EntityType type) {
+  std::string data;
+  const std::string etag = this->etag_(this->append_state_json_(source, type, data));
+  if (this->send_not_modified_(request, "application/json", etag))
+    return;
+  AsyncWebServerResponse *response = request->beginResponse(200, "application/json", data.c_str());
+  response->addHeader(HEADER_ETAG, etag.c_str());
+  request->send(response);
+}
+void WebServer::handle_states_request(AsyncWebServerRequest *request) {
+  std::string data = "{\"states\":[";
+  std::string etag;
+  {
+    LockGuard guard{this->rendered_states_lock_};
+    // every state change counts up the version, so it stands for all states
+    etag = this->etag_(this->state_version_);
+  }
+  if (this->send_not_modified_(request, "application/json", etag))
+    return;
+
+  auto add = [this, &data](EntityBase *source, EntityType type) {
+    if (source->is_internal() && !this->include_internal_)
+      return;
+    if (data.back() != '[')
+      data.push_back(',');
+    this->append_state_json_(source, type, data);
+  };
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    add(obj, ENTITY_TYPE_BINARY_SENSOR);
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches())
+    add(obj, ENTITY_TYPE_SWITCH);
+#endif
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors())
+    add(obj, ENTITY_TYPE_SENSOR);
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors())
+    add(obj, ENTITY_TYPE_TEXT_SENSOR);
+#endif
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans())
+    add(obj, ENTITY_TYPE_FAN);
+#endif
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers())
+    add(obj, ENTITY_TYPE_COVER);
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights())
+    add(obj, ENTITY_TYPE_LIGHT);
+#endif
+#ifdef USE_CLIMATE
+  for (auto *obj : App.get_climates())
+    add(obj, ENTITY_TYPE_CLIMATE);
+#endif
+#ifdef USE_NUMBER
+  for (auto *obj : App.get_numbers())
+    add(obj, ENTITY_TYPE_NUMBER);
+#endif
+#ifdef USE_TEXT
+  for (auto *obj : App.get_texts())
+    add(obj, ENTITY_TYPE_TEXT);
+#endif
+#ifdef USE_SELECT
+  for (auto *obj : App.get_selects())
+    add(obj, ENTITY_TYPE_SELECT);
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : App.get_locks())
+    add(obj, ENTITY_TYPE_LOCK);
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  for (auto *obj : App.get_alarm_control_panels())
+    add(obj, ENTITY_TYPE_ALARM_CONTROL_PANEL);
+#endif
+  data.append("]}");
+
+  AsyncWebServerResponse *response = request->beginResponse(200, "application/json", data.c_str());
+  response->addHeader(HEADER_ETAG, etag.c_str());
+  request->send(response);
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -172,8 +475,12 @@ float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f
 
 #ifdef USE_WEBSERVER_LOCAL
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
+  const std::string etag = this->index_etag_();
+  if (this->send_not_modified_(request, "text/html", etag))
+    return;
   AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", INDEX_GZ, sizeof(INDEX_GZ));
   response->addHeader("Content-Encoding", "gzip");
+  response->addHeader(HEADER_ETAG, etag.c_str());
   request->send(response);
 }
 #elif USE_WEBSERVER_VERSION == 1
@@ -359,9 +666,13 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 }
 #elif USE_WEBSERVER_VERSION == 2
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
+  const std::string etag = this->index_etag_();
+  if (this->send_not_modified_(request, "text/html", etag))
+    return;
   AsyncWebServerResponse *response =
       request->beginResponse_P(200, "text/html", ESPHOME_WEBSERVER_INDEX_HTML, ESPHOME_WEBSERVER_INDEX_HTML_SIZE);
   // No gzip header here because the HTML file is so small
+  response->addHeader(HEADER_ETAG, etag.c_str());
   request->send(response);
 }
 #endif
@@ -377,6 +688,52 @@ void WebServer::handle_pna_cors_request(AsyncWebServerRequest *request) {
 }
 #endif
 
+#ifdef USE_PROFILER
+void WebServer::handle_profile_request(AsyncWebServerRequest *request) {
+  if (request->method() == HTTP_POST) {
+    this->schedule_([]() { profiler::global_profiler->reset(); });
+    request->send(200);
+    return;
+  }
+
+  const uint32_t duration = profiler::global_profiler->get_duration();
+  const std::vector<profiler::ProfileStats> snapshot = profiler::global_profiler->snapshot();
+  std::string data = json::write_json([duration, &snapshot](json::JsonObjectWriter root) {
+    root.add("duration", duration);
+    json::JsonArrayWriter stats_array = root.create_nested_array("stats");
+    for (const auto &stats : snapshot) {
+      json::JsonObjectWriter obj = stats_array.create_nested_object();
+      obj.add("component", stats.get_component_source());
+      obj.add("instance", stats.instance);
+      obj.add("section", profiler::profile_section_to_string(stats.section));
+      obj.add("name", stats.name);
+      obj.add("count", stats.count);
+      obj.add("total_ms", uint32_t(stats.total_us / 1000));
+      obj.add("max_us", stats.max_us);
+      obj.add("p99_us", stats.percentile(99));
+    }
+  });
+  request->send(200, "application/json", data.c_str());
+}
+#endif
+
+#ifdef USE_LOGGER_HISTORY
+void WebServer::handle_log_history_request(AsyncWebServerRequest *request) {
+  logger::LogHistory &history = logger::global_logger->get_history();
+  if (request->method() == HTTP_POST) {
+    history.clear_previous();
+    request->send(200);
+    return;
+  }
+
+  const std::string data = request->hasParam("current") ? history.get_current() : history.get_previous();
+  AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", data.c_str());
+  if (!history.get_reset_reason().empty())
+    response->addHeader("X-Reset-Reason", history.get_reset_reason().c_str());
+  request->send(response);
+}
+#endif
+
 #ifdef USE_WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
   AsyncWebServerResponse *response =
@@ -396,37 +753,92 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 #endif
 
 #define set_json_id(root, obj, sensor, start_config) \
-  (root)["id"] = sensor; \
+  (root).add("id", sensor); \
   if (((start_config) == DETAIL_ALL)) \
-    (root)["name"] = (obj)->get_name();
+    (root).add("name", (obj)->get_name());
 
 #define set_json_value(root, obj, sensor, value, start_config) \
-  set_json_id((root), (obj), sensor, start_config)(root)["value"] = value;
+  set_json_id((root), (obj), sensor, start_config)(root).add("value", value);
 
 #define set_json_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state;
+  set_json_value(root, obj, sensor, value, start_config)(root).add("state", state);
 
 #define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state; \
+  set_json_value(root, obj, sensor, value, start_config)(root).add("state", state); \
   if (((start_config) == DETAIL_ALL)) \
-    (root)["icon"] = (obj)->get_icon();
+    (root).add("icon", (obj)->get_icon());
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_SENSOR);
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+  sensor::Sensor *obj = App.get_sensor_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+#ifdef USE_SENSOR_HISTORY
+  if (match.method == "history") {
+    this->handle_sensor_history_request(request, obj);
+    return;
+  }
+#endif
+  this->send_state_(request, obj, ENTITY_TYPE_SENSOR);
 }
+#ifdef USE_SENSOR_HISTORY
+void WebServer::handle_sensor_history_request(AsyncWebServerRequest *request, sensor::Sensor *obj) {
+  sensor::SensorHistory *history = obj->get_history();
+  if (history == nullptr) {
+    request->send(404);
+    return;
+  }
+
+  sensor::SensorHistoryResolution resolution = sensor::SENSOR_HISTORY_RAW;
+  std::string resolution_name = "raw";
+  if (request->hasParam("resolution")) {
+    resolution_name = request->getParam("resolution")->value().c_str();
+    if (resolution_name == "minute") {
+      resolution = sensor::SENSOR_HISTORY_MINUTE;
+    } else if (resolution_name == "hour") {
+      resolution = sensor::SENSOR_HISTORY_HOUR;
+    } else if (resolution_name != "raw") {
+      request->send(400);
+      return;
+    }
+  }
+  uint32_t max_age_ms = 0;
+  if (request->hasParam("max_age_ms")) {
+    auto parsed = parse_number<uint32_t>(request->getParam("max_age_ms")->value().c_str());
+    if (!parsed.has_value()) {
+      request->send(400);
+      return;
+    }
+    max_age_ms = *parsed;
+  }
+
+  const std::vector<sensor::SensorHistoryPoint> points = history->query(resolution, max_age_ms);
+  std::string data = json::write_json([obj, resolution, &resolution_name, &points](json::JsonObjectWriter root) {
+    root.add("id", "sensor-" + obj->get_object_id());
+    root.add("resolution", resolution_name);
+    // [age_ms, value] for raw points, [age_ms, mean, min, max] for aggregates
+    json::JsonArrayWriter points_array = root.create_nested_array("points");
+    for (const auto &point : points) {
+      json::JsonArrayWriter point_array = points_array.create_nested_array();
+      point_array.add(point.age_ms);
+      point_array.add(point.mean);
+      if (resolution != sensor::SENSOR_HISTORY_RAW) {
+        point_array.add(point.min);
+        point_array.add(point.max);
+      }
+    }
+  });
+  request->send(200, "application/json", data.c_str());
+}
+#endif
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     std::string state;
     if (std::isnan(value)) {
       state = "NA";
@@ -442,21 +854,20 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_TEXT_SENSOR);
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+  text_sensor::TextSensor *obj = App.get_text_sensor_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  this->send_state_(request, obj, ENTITY_TYPE_TEXT_SENSOR);
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, &value, start_config](json::JsonObjectWriter root) {
     set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
   });
 }
@@ -464,251 +875,245 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_SWITCH);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
     if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
+      root.add("assumed_state", obj->assumed_state());
     }
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->schedule_([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->schedule_([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  switch_::Switch *obj = App.get_switch_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_SWITCH);
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    this->schedule_([obj]() { obj->turn_on(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->schedule_([obj]() { obj->turn_off(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BUTTON
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+  return json::write_json([obj, start_config](json::JsonObjectWriter root) {
+    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+  });
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    if (request->method() == HTTP_POST && match.method == "press") {
-      this->schedule_([obj]() { obj->press(); });
-      request->send(200);
-      return;
-    } else {
-      request->send(404);
-    }
+  button::Button *obj = App.get_button_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_POST && match.method == "press") {
+    this->schedule_([obj]() { obj->press(); });
+    request->send(200);
+    return;
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_BINARY_SENSOR);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     set_json_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
+  binary_sensor::BinarySensor *obj = App.get_binary_sensor_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  this->send_state_(request, obj, ENTITY_TYPE_BINARY_SENSOR);
 }
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
+void WebServer::on_fan_update(fan::Fan *obj) { this->on_state_change_(obj, ENTITY_TYPE_FAN); }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonObjectWriter root) {
     set_json_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state, start_config);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
+      root.add("speed_level", obj->speed);
+      root.add("speed_count", traits.supported_speed_count());
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.add("oscillation", obj->oscillating);
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  fan::Fan *obj = App.get_fan_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed_level")) {
-        auto speed_level = request->getParam("speed_level")->value();
-        auto val = parse_number<int>(speed_level.c_str());
-        if (!val.has_value()) {
-          ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
-          return;
-        }
-        call.set_speed(*val);
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_FAN);
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("speed_level")) {
+      auto speed_level = request->getParam("speed_level")->value();
+      auto val = parse_number<int>(speed_level.c_str());
+      if (!val.has_value()) {
+        ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+        return;
       }
-      if (request->hasParam("oscillation")) {
-        auto speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
+      call.set_speed(*val);
+    }
+    if (request->hasParam("oscillation")) {
+      auto speed = request->getParam("oscillation")->value();
+      auto val = parse_on_off(speed.c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          request->send(404);
+          return;
       }
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->schedule_([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->schedule_([obj]() { obj->turn_off().perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_LIGHT
-void WebServer::on_light_update(light::LightState *obj) {
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
-}
+void WebServer::on_light_update(light::LightState *obj) { this->on_state_change_(obj, ENTITY_TYPE_LIGHT); }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  light::LightState *obj = App.get_light_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness")) {
-        auto brightness = parse_number<float>(request->getParam("brightness")->value().c_str());
-        if (brightness.has_value()) {
-          call.set_brightness(*brightness / 255.0f);
-        }
-      }
-      if (request->hasParam("r")) {
-        auto r = parse_number<float>(request->getParam("r")->value().c_str());
-        if (r.has_value()) {
-          call.set_red(*r / 255.0f);
-        }
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_LIGHT);
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("brightness")) {
+      auto brightness = parse_number<float>(request->getParam("brightness")->value().c_str());
+      if (brightness.has_value()) {
+        call.set_brightness(*brightness / 255.0f);
       }
-      if (request->hasParam("g")) {
-        auto g = parse_number<float>(request->getParam("g")->value().c_str());
-        if (g.has_value()) {
-          call.set_green(*g / 255.0f);
-        }
+    }
+    if (request->hasParam("r")) {
+      auto r = parse_number<float>(request->getParam("r")->value().c_str());
+      if (r.has_value()) {
+        call.set_red(*r / 255.0f);
       }
-      if (request->hasParam("b")) {
-        auto b = parse_number<float>(request->getParam("b")->value().c_str());
-        if (b.has_value()) {
-          call.set_blue(*b / 255.0f);
-        }
+    }
+    if (request->hasParam("g")) {
+      auto g = parse_number<float>(request->getParam("g")->value().c_str());
+      if (g.has_value()) {
+        call.set_green(*g / 255.0f);
       }
-      if (request->hasParam("white_value")) {
-        auto white_value = parse_number<float>(request->getParam("white_value")->value().c_str());
-        if (white_value.has_value()) {
-          call.set_white(*white_value / 255.0f);
-        }
+    }
+    if (request->hasParam("b")) {
+      auto b = parse_number<float>(request->getParam("b")->value().c_str());
+      if (b.has_value()) {
+        call.set_blue(*b / 255.0f);
       }
-      if (request->hasParam("color_temp")) {
-        auto color_temp = parse_number<float>(request->getParam("color_temp")->value().c_str());
-        if (color_temp.has_value()) {
-          call.set_color_temperature(*color_temp);
-        }
+    }
+    if (request->hasParam("white_value")) {
+      auto white_value = parse_number<float>(request->getParam("white_value")->value().c_str());
+      if (white_value.has_value()) {
+        call.set_white(*white_value / 255.0f);
       }
-      if (request->hasParam("flash")) {
-        auto flash = parse_number<uint32_t>(request->getParam("flash")->value().c_str());
-        if (flash.has_value()) {
-          call.set_flash_length(*flash * 1000);
-        }
+    }
+    if (request->hasParam("color_temp")) {
+      auto color_temp = parse_number<float>(request->getParam("color_temp")->value().c_str());
+      if (color_temp.has_value()) {
+        call.set_color_temperature(*color_temp);
       }
-      if (request->hasParam("transition")) {
-        auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
-        if (transition.has_value()) {
-          call.set_transition_length(*transition * 1000);
-        }
+    }
+    if (request->hasParam("flash")) {
+      auto flash = parse_number<uint32_t>(request->getParam("flash")->value().c_str());
+      if (flash.has_value()) {
+        call.set_flash_length(*flash * 1000);
       }
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
+    }
+    if (request->hasParam("transition")) {
+      auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
+      if (transition.has_value()) {
+        call.set_transition_length(*transition * 1000);
       }
+    }
+    if (request->hasParam("effect")) {
+      const char *effect = request->getParam("effect")->value().c_str();
+      call.set_effect(effect);
+    }
 
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
-        if (transition.has_value()) {
-          call.set_transition_length(*transition * 1000);
-        }
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    auto call = obj->turn_off();
+    if (request->hasParam("transition")) {
+      auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
+      if (transition.has_value()) {
+        call.set_transition_length(*transition * 1000);
       }
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonObjectWriter root) {
     set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
+    // dump_json() adds the state of lights that can be switched, the writer doesn't replace keys
+    if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
+      root.add("state", obj->remote_values.is_on() ? "ON" : "OFF");
 
     light::LightJSONSchema::dump_json(*obj, root);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
+      json::JsonArrayWriter opt = root.create_nested_array("effects");
       opt.add("None");
       for (auto const &option : obj->get_effects()) {
         opt.add(option->get_name());
@@ -719,121 +1124,115 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 #endif
 
 #ifdef USE_COVER
-void WebServer::on_cover_update(cover::Cover *obj) {
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
-}
+void WebServer::on_cover_update(cover::Cover *obj) { this->on_state_change_(obj, ENTITY_TYPE_COVER); }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  cover::Cover *obj = App.get_cover_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      continue;
-    }
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_COVER);
+    return;
+  }
 
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto call = obj->make_call();
+  if (match.method == "open") {
+    call.set_command_open();
+  } else if (match.method == "close") {
+    call.set_command_close();
+  } else if (match.method == "stop") {
+    call.set_command_stop();
+  } else if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  auto traits = obj->get_traits();
+  if ((request->hasParam("position") && !traits.get_supports_position()) ||
+      (request->hasParam("tilt") && !traits.get_supports_tilt())) {
+    request->send(409);
+    return;
+  }
 
-    if (request->hasParam("position")) {
-      auto position = parse_number<float>(request->getParam("position")->value().c_str());
-      if (position.has_value()) {
-        call.set_position(*position);
-      }
+  if (request->hasParam("position")) {
+    auto position = parse_number<float>(request->getParam("position")->value().c_str());
+    if (position.has_value()) {
+      call.set_position(*position);
     }
-    if (request->hasParam("tilt")) {
-      auto tilt = parse_number<float>(request->getParam("tilt")->value().c_str());
-      if (tilt.has_value()) {
-        call.set_tilt(*tilt);
-      }
+  }
+  if (request->hasParam("tilt")) {
+    auto tilt = parse_number<float>(request->getParam("tilt")->value().c_str());
+    if (tilt.has_value()) {
+      call.set_tilt(*tilt);
     }
-
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonObjectWriter root) {
     set_json_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
                          obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+    root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.add("tilt", obj->tilt);
   });
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_NUMBER);
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->number_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
-
-    auto call = obj->make_call();
-    if (request->hasParam("value")) {
-      auto value = parse_number<float>(request->getParam("value")->value().c_str());
-      if (value.has_value())
-        call.set_value(*value);
-    }
+  number::Number *obj = App.get_number_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_NUMBER);
     return;
   }
-  request->send(404);
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
+
+  auto call = obj->make_call();
+  if (request->hasParam("value")) {
+    auto value = parse_number<float>(request->getParam("value")->value().c_str());
+    if (value.has_value())
+      call.set_value(*value);
+  }
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
-      root["min_value"] = obj->traits.get_min_value();
-      root["max_value"] = obj->traits.get_max_value();
-      root["step"] = obj->traits.get_step();
-      root["mode"] = (int) obj->traits.get_mode();
+      root.add("min_value", obj->traits.get_min_value());
+      root.add("max_value", obj->traits.get_max_value());
+      root.add("step", obj->traits.get_step());
+      root.add("mode", (int) obj->traits.get_mode());
     }
     if (std::isnan(value)) {
-      root["value"] = "\"NaN\"";
-      root["state"] = "NA";
+      root.add("value", "\"NaN\"");
+      root.add("state", "NA");
     } else {
-      root["value"] = value;
+      root.add("value", value);
       std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
       if (!obj->traits.get_unit_of_measurement().empty())
         state += " " + obj->traits.get_unit_of_measurement();
-      root["state"] = state;
+      root.add("state", state);
     }
   });
 }
@@ -841,98 +1240,96 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_TEXT
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_TEXT);
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_texts()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->text_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
-
-    auto call = obj->make_call();
-    if (request->hasParam("value")) {
-      String value = request->getParam("value")->value();
-      call.set_value(value.c_str());
-    }
+  text::Text *obj = App.get_text_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_TEXT);
     return;
   }
-  request->send(404);
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
+
+  auto call = obj->make_call();
+  if (request->hasParam("value")) {
+    String value = request->getParam("value")->value();
+    call.set_value(value.c_str());
+  }
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, &value, start_config](json::JsonObjectWriter root) {
     set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
-      root["mode"] = (int) obj->traits.get_mode();
+      root.add("mode", (int) obj->traits.get_mode());
     }
-    root["min_length"] = obj->traits.get_min_length();
-    root["max_length"] = obj->traits.get_max_length();
-    root["pattern"] = obj->traits.get_pattern();
+    root.add("min_length", obj->traits.get_min_length());
+    root.add("max_length", obj->traits.get_max_length());
+    root.add("pattern", obj->traits.get_pattern());
     if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
-      root["state"] = "********";
+      root.add("state", "********");
     } else {
-      root["state"] = value;
+      root.add("state", value);
     }
-    root["value"] = value;
+    root.add("value", value);
   });
 }
 #endif
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_SELECT);
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      auto detail = DETAIL_STATE;
-      auto *param = request->getParam("detail");
-      if (param && param->value() == "all") {
-        detail = DETAIL_ALL;
-      }
-      std::string data = this->select_json(obj, obj->state, detail);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
+  select::Select *obj = App.get_select_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
+  if (request->method() == HTTP_GET) {
+    auto *param = request->getParam("detail");
+    if (param && param->value() == "all") {
+      // only the state detail is cached, the full one is rarely asked for
+      std::string data = this->select_json(obj, obj->state, DETAIL_ALL);
+      request->send(200, "application/json", data.c_str());
+    } else {
+      this->send_state_(request, obj, ENTITY_TYPE_SELECT);
     }
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("option")) {
-      auto option = request->getParam("option")->value();
-      call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
-    }
+  auto call = obj->make_call();
 
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("option")) {
+    auto option = request->getParam("option")->value();
+    call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, &value, start_config](json::JsonObjectWriter root) {
     set_json_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
+      json::JsonArrayWriter opt = root.create_nested_array("option");
       for (auto &option : obj->traits.get_options()) {
         opt.add(option);
       }
@@ -945,60 +1342,56 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 #define PSTR_LOCAL(mode_s) strncpy_P(buf, (PGM_P) ((mode_s)), 15)
 
 #ifdef USE_CLIMATE
-void WebServer::on_climate_update(climate::Climate *obj) {
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
-}
+void WebServer::on_climate_update(climate::Climate *obj) { this->on_state_change_(obj, ENTITY_TYPE_CLIMATE); }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_climates()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->climate_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
+  climate::Climate *obj = App.get_climate_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_CLIMATE);
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("mode")) {
-      auto mode = request->getParam("mode")->value();
-      call.set_mode(mode.c_str());
-    }
+  auto call = obj->make_call();
 
-    if (request->hasParam("target_temperature_high")) {
-      auto target_temperature_high = parse_number<float>(request->getParam("target_temperature_high")->value().c_str());
-      if (target_temperature_high.has_value())
-        call.set_target_temperature_high(*target_temperature_high);
-    }
+  if (request->hasParam("mode")) {
+    auto mode = request->getParam("mode")->value();
+    call.set_mode(mode.c_str());
+  }
 
-    if (request->hasParam("target_temperature_low")) {
-      auto target_temperature_low = parse_number<float>(request->getParam("target_temperature_low")->value().c_str());
-      if (target_temperature_low.has_value())
-        call.set_target_temperature_low(*target_temperature_low);
-    }
+  if (request->hasParam("target_temperature_high")) {
+    auto target_temperature_high = parse_number<float>(request->getParam("target_temperature_high")->value().c_str());
+    if (target_temperature_high.has_value())
+      call.set_target_temperature_high(*target_temperature_high);
+  }
 
-    if (request->hasParam("target_temperature")) {
-      auto target_temperature = parse_number<float>(request->getParam("target_temperature")->value().c_str());
-      if (target_temperature.has_value())
-        call.set_target_temperature(*target_temperature);
-    }
+  if (request->hasParam("target_temperature_low")) {
+    auto target_temperature_low = parse_number<float>(request->getParam("target_temperature_low")->value().c_str());
+    if (target_temperature_low.has_value())
+      call.set_target_temperature_low(*target_temperature_low);
+  }
 
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("target_temperature")) {
+    auto target_temperature = parse_number<float>(request->getParam("target_temperature")->value().c_str());
+    if (target_temperature.has_value())
+      call.set_target_temperature(*target_temperature);
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonObjectWriter root) {
     set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
     const auto traits = obj->get_traits();
     int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
@@ -1006,153 +1399,160 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
     char buf[16];
 
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("modes");
+      json::JsonArrayWriter opt = root.create_nested_array("modes");
       for (climate::ClimateMode m : traits.get_supported_modes())
         opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("fan_modes");
+        json::JsonArrayWriter opt = root.create_nested_array("fan_modes");
         for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
           opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
       }
 
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("custom_fan_modes");
+        json::JsonArrayWriter opt = root.create_nested_array("custom_fan_modes");
         for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
           opt.add(custom_fan_mode);
       }
       if (traits.get_supports_swing_modes()) {
-        JsonArray opt = root.createNestedArray("swing_modes");
+        json::JsonArrayWriter opt = root.create_nested_array("swing_modes");
         for (auto swing_mode : traits.get_supported_swing_modes())
           opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
       }
       if (traits.get_supports_presets() && obj->preset.has_value()) {
-        JsonArray opt = root.createNestedArray("presets");
+        json::JsonArrayWriter opt = root.create_nested_array("presets");
         for (climate::ClimatePreset m : traits.get_supported_presets())
           opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
       }
       if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-        JsonArray opt = root.createNestedArray("custom_presets");
+        json::JsonArrayWriter opt = root.create_nested_array("custom_presets");
         for (auto const &custom_preset : traits.get_supported_custom_presets())
           opt.add(custom_preset);
       }
     }
 
     bool has_state = false;
-    root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
-    root["max_temp"] = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
-    root["min_temp"] = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
-    root["step"] = traits.get_visual_target_temperature_step();
+    root.add("mode", PSTR_LOCAL(climate_mode_to_string(obj->mode)));
+    root.add("max_temp", value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy));
+    root.add("min_temp", value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy));
+    root.add("step", traits.get_visual_target_temperature_step());
     if (traits.get_supports_action()) {
-      root["action"] = PSTR_LOCAL(climate_action_to_string(obj->action));
-      root["state"] = root["action"];
+      const char *action = PSTR_LOCAL(climate_action_to_string(obj->action));
+      root.add("action", action);
+      root.add("state", action);
       has_state = true;
     }
     if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
-      root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
+      root.add("fan_mode", PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value())));
     }
     if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
-      root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+      root.add("custom_fan_mode", obj->custom_fan_mode.value().c_str());
     }
     if (traits.get_supports_presets() && obj->preset.has_value()) {
-      root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+      root.add("preset", PSTR_LOCAL(climate_preset_to_string(obj->preset.value())));
     }
     if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-      root["custom_preset"] = obj->custom_preset.value().c_str();
+      root.add("custom_preset", obj->custom_preset.value().c_str());
     }
     if (traits.get_supports_swing_modes()) {
-      root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
+      root.add("swing_mode", PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode)));
     }
     if (traits.get_supports_current_temperature()) {
       if (!std::isnan(obj->current_temperature)) {
-        root["current_temperature"] = value_accuracy_to_string(obj->current_temperature, current_accuracy);
+        root.add("current_temperature", value_accuracy_to_string(obj->current_temperature, current_accuracy));
       } else {
-        root["current_temperature"] = "NA";
+        root.add("current_temperature", "NA");
       }
     }
     if (traits.get_supports_two_point_target_temperature()) {
-      root["target_temperature_low"] = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
-      root["target_temperature_high"] = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
+      root.add("target_temperature_low", value_accuracy_to_string(obj->target_temperature_low, target_accuracy));
+      root.add("target_temperature_high", value_accuracy_to_string(obj->target_temperature_high, target_accuracy));
       if (!has_state) {
-        root["state"] = value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
-                                                 target_accuracy);
+        root.add("state", value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
+                                                   target_accuracy));
       }
     } else {
-      root["target_temperature"] = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+      const std::string target_temperature = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+      root.add("target_temperature", target_temperature);
       if (!has_state)
-        root["state"] = root["target_temperature"];
+        root.add("state", target_temperature);
     }
   });
 }
 #endif
 
 #ifdef USE_LOCK
-void WebServer::on_lock_update(lock::Lock *obj) {
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
-}
+void WebServer::on_lock_update(lock::Lock *obj) { this->on_state_change_(obj, ENTITY_TYPE_LOCK); }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
                               start_config);
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->lock_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "lock") {
-      this->schedule_([obj]() { obj->lock(); });
-      request->send(200);
-    } else if (match.method == "unlock") {
-      this->schedule_([obj]() { obj->unlock(); });
-      request->send(200);
-    } else if (match.method == "open") {
-      this->schedule_([obj]() { obj->open(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  lock::Lock *obj = App.get_lock_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_LOCK);
+  } else if (match.method == "lock") {
+    this->schedule_([obj]() { obj->lock(); });
+    request->send(200);
+  } else if (match.method == "unlock") {
+    this->schedule_([obj]() { obj->unlock(); });
+    request->send(200);
+  } else if (match.method == "open") {
+    this->schedule_([obj]() { obj->open(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->on_state_change_(obj, ENTITY_TYPE_ALARM_CONTROL_PANEL);
 }
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
                                                 JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonObjectWriter root) {
     char buf[16];
     set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
                               PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
   });
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  alarm_control_panel::AlarmControlPanel *obj = App.get_alarm_control_panel_by_object_id(match.id);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    this->send_state_(request, obj, ENTITY_TYPE_ALARM_CONTROL_PANEL);
+    return;
   }
   request->send(404);
 }
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
+#ifdef USE_ARDUINO
+  // keep the header for the ETag check, the others are dropped
+  if (request->method() == HTTP_GET)
+    request->addInterestingHeader(HEADER_IF_NONE_MATCH);
+#endif
+
   if (request->url() == "/")
     return true;
 
+  if (request->url() == "/states" && request->method() == HTTP_GET)
+    return true;
+
 #ifdef USE_WEBSERVER_CSS_INCLUDE
   if (request->url() == "/0.css")
     return true;
@@ -1163,6 +1563,16 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
     return true;
 #endif
 
+#ifdef USE_PROFILER
+  if (request->url() == "/profile")
+    return true;
+#endif
+
+#ifdef USE_LOGGER_HISTORY
+  if (request->url() == "/log_history")
+    return true;
+#endif
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
   if (request->method() == HTTP_OPTIONS && request->hasHeader(HEADER_CORS_REQ_PNA)) {
 #ifdef USE_ARDUINO
@@ -1256,6 +1666,11 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
     return;
   }
 
+  if (request->url() == "/states") {
+    this->handle_states_request(request);
+    return;
+  }
+
 #ifdef USE_WEBSERVER_CSS_INCLUDE
   if (request->url() == "/0.css") {
     this->handle_css_request(request);
@@ -1270,6 +1685,20 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
+#ifdef USE_PROFILER
+  if (request->url() == "/profile") {
+    this->handle_profile_request(request);
+    return;
+  }
+#endif
+
+#ifdef USE_LOGGER_HISTORY
+  if (request->url() == "/log_history") {
+    this->handle_log_history_request(request);
+    return;
+  }
+#endif
+
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
   if (request->method() == HTTP_OPTIONS && request->hasHeader(HEADER_CORS_REQ_PNA)) {
     this->handle_pna_cors_request(request);
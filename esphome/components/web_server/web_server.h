@@ -3,12 +3,14 @@
 #include "list_entities.h"
 
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "esphome/core/application.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 
+#include <deque>
+#include <map>
 #include <vector>
 #ifdef USE_ESP32
-#include <deque>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #endif
@@ -117,6 +119,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   /// Handle an index request under '/'.
   void handle_index_request(AsyncWebServerRequest *request);
 
+  /// Handle a request for the states of all entities under '/states'.
+  void handle_states_request(AsyncWebServerRequest *request);
+
   /// Return the webserver configuration as JSON.
   std::string get_config_json();
 
@@ -135,10 +140,27 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   void handle_pna_cors_request(AsyncWebServerRequest *request);
 #endif
 
+#ifdef USE_PROFILER
+  /// Handle a profiler request under '/profile', GET returns the statistics and POST resets them.
+  void handle_profile_request(AsyncWebServerRequest *request);
+#endif
+
+#ifdef USE_LOGGER_HISTORY
+  /// Handle a log history request under '/log_history', returns the lines that led up to the last reset as text.
+  /// With the 'current' parameter, the lines of the current boot are returned instead. POST frees the lines that led
+  /// up to the last reset.
+  void handle_log_history_request(AsyncWebServerRequest *request);
+#endif
+
 #ifdef USE_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
   /// Handle a sensor request under '/sensor/<id>'.
   void handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match);
+#ifdef USE_SENSOR_HISTORY
+  /// Handle a sensor history request under '/sensor/<id>/history', returns the points as JSON. The 'resolution'
+  /// parameter selects raw (default), minute or hour points, 'max_age_ms' limits how far back they go.
+  void handle_sensor_history_request(AsyncWebServerRequest *request, sensor::Sensor *obj);
+#endif
 
   /// Dump the sensor state with its value as a JSON string.
   std::string sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config);
@@ -279,9 +301,61 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
  protected:
   void schedule_(std::function<void()> &&f);
   friend ListEntitiesIterator;
+
+  /// Maximum number of log lines that wait for the next loop, older ones are dropped.
+  static const size_t MAX_DEFERRED_LOG_LINES = 32;
+#ifdef USE_ARDUINO
+  /// Events wait while the clients have this many packets queued on average.
+  static const size_t MAX_PACKETS_WAITING = 16;
+#endif
+
+  /// A state event that waits for the next loop. Its JSON is built then, from the latest state.
+  struct DeferredStateEvent {
+    EntityBase *source;
+    EntityType type;
+  };
+
+  /// The state JSON of an entity as last rendered, with the state version it was changed at.
+  struct RenderedState {
+    uint32_t version;
+    std::string json;
+  };
+
+  /// Drop the rendered state of the entity and queue a state event for it, unless one is already waiting.
+  void on_state_change_(EntityBase *source, EntityType type);
+#ifdef USE_LOGGER
+  void defer_log_event_(const char *message);
+#endif
+  /// Send the waiting events, which the event source sends on as one chunk per client where it can.
+  void flush_events_();
+  std::string state_json_(EntityBase *source, EntityType type);
+  /// Append the state JSON of the entity, rendering it only if it changed, and return its version.
+  uint32_t append_state_json_(EntityBase *source, EntityType type, std::string &out);
+  std::string etag_(uint32_t version) const;
+  std::string index_etag_() const;
+  /// Answer with 304 Not Modified if the client already has this ETag.
+  bool send_not_modified_(AsyncWebServerRequest *request, const char *content_type, const std::string &etag);
+  void send_state_(AsyncWebServerRequest *request, EntityBase *source, EntityType type);
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   ListEntitiesIterator entities_iterator_;
+#ifdef USE_ESP_IDF
+  /// Sends the states again to the clients that lost events, one client at a time.
+  ListEntitiesIterator resync_iterator_{this};
+  std::deque<AsyncEventSourceClient *> resync_clients_;
+#endif
+  std::vector<DeferredStateEvent> deferred_states_;
+  std::map<const EntityBase *, RenderedState> rendered_states_;
+  /// Counts up on every state change, so it stands for the states of all entities.
+  uint32_t state_version_{0};
+  uint32_t boot_id_{0};
+  /// Requests are handled outside of the main loop.
+  Mutex rendered_states_lock_;
+#ifdef USE_LOGGER
+  std::deque<std::string> deferred_logs_;
+  uint32_t dropped_log_lines_{0};
+#endif
 #if USE_WEBSERVER_VERSION == 1
   const char *css_url_{nullptr};
   const char *js_url_{nullptr};
@@ -1,17 +1,23 @@
 #ifdef USE_ESP_IDF
 
+#include <algorithm>
 #include <cstdarg>
 
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
 #include "esp_tls_crypto.h"
+#include "lwip/sockets.h"
 
 #include "web_server_idf.h"
 
 namespace esphome {
 namespace web_server_idf {
 
+#ifndef HTTPD_304
+#define HTTPD_304 "304 Not Modified"
+#endif
+
 #ifndef HTTPD_409
 #define HTTPD_409 "409 Conflict"
 #endif
@@ -137,6 +143,7 @@ void AsyncWebServerRequest::redirect(const std::string &url) {
 
 void AsyncWebServerRequest::init_response_(AsyncWebServerResponse *rsp, int code, const char *content_type) {
   httpd_resp_set_status(*this, code == 200   ? HTTPD_200
+                               : code == 304 ? HTTPD_304
                                : code == 404 ? HTTPD_404
                                : code == 409 ? HTTPD_409
                                              : to_string(code).c_str());
@@ -287,6 +294,10 @@ void AsyncResponseStream::printf(const char *fmt, ...) {
 }
 
 AsyncEventSource::~AsyncEventSource() {
+  LockGuard guard{this->sessions_lock_};
+  for (auto *ses : this->new_sessions_) {
+    delete ses;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
   for (auto *ses : this->sessions_) {
     delete ses;  // NOLINT(cppcoreguidelines-owning-memory)
   }
@@ -294,18 +305,45 @@ AsyncEventSource::~AsyncEventSource() {
 
 void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
   auto *rsp = new AsyncEventSourceResponse(request, this);  // NOLINT(cppcoreguidelines-owning-memory)
-  if (this->on_connect_) {
-    this->on_connect_(rsp);
-  }
-  this->sessions_.insert(rsp);
+  // runs in the HTTP server task, the main loop hands the client to the connect handler
+  LockGuard guard{this->sessions_lock_};
+  this->new_sessions_.push_back(rsp);
 }
 
 void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  LockGuard guard{this->sessions_lock_};
   for (auto *ses : this->sessions_) {
     ses->send(message, event, id, reconnect);
   }
 }
 
+bool AsyncEventSource::send_to(AsyncEventSourceClient *client, const char *message, const char *event) {
+  LockGuard guard{this->sessions_lock_};
+  if (this->sessions_.count(client) == 0)
+    return false;
+  client->send(message, event);
+  return true;
+}
+
+void AsyncEventSource::loop() {
+  LockGuard guard{this->sessions_lock_};
+  for (auto *ses : this->new_sessions_) {
+    if (this->on_connect_) {
+      this->on_connect_(ses);
+    }
+    this->sessions_.insert(ses);
+  }
+  this->new_sessions_.clear();
+  for (auto *ses : this->sessions_) {
+    ses->flush_();
+  }
+}
+
+size_t AsyncEventSource::count() {
+  LockGuard guard{this->sessions_lock_};
+  return this->new_sessions_.size() + this->sessions_.size();
+}
+
 AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server)
     : server_(server) {
   httpd_req_t *req = *request;
@@ -330,7 +368,11 @@ AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *
 
 void AsyncEventSourceResponse::destroy(void *ptr) {
   auto *rsp = static_cast<AsyncEventSourceResponse *>(ptr);
-  rsp->server_->sessions_.erase(rsp);
+  AsyncEventSource *server = rsp->server_;
+  LockGuard guard{server->sessions_lock_};
+  server->sessions_.erase(rsp);
+  auto &new_sessions = server->new_sessions_;
+  new_sessions.erase(std::remove(new_sessions.begin(), new_sessions.end(), rsp), new_sessions.end());
   delete rsp;  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
@@ -371,15 +413,58 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
 
   ev.append(CRLF_STR, CRLF_LEN);
 
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
+  if (this->batch_.size() + (this->chunk_.size() - this->chunk_sent_) + ev.size() > MAX_PENDING_SIZE) {
+    this->overflowed_ = true;
+    return;
+  }
+  this->batch_.append(ev);
+}
+
+void AsyncEventSourceResponse::flush_() {
+  if (this->fd_ == 0) {
+    return;
+  }
 
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
+  if (this->chunk_sent_ == this->chunk_.size()) {
+    this->chunk_.clear();
+    this->chunk_sent_ = 0;
+    if (this->batch_.empty()) {
+      if (this->overflowed_ && this->server_->on_resync_) {
+        // caught up, have the current states sent to this client again
+        this->overflowed_ = false;
+        this->server_->on_resync_(this);
+      }
+      return;
+    }
+
+    // Chunked content prelude, the events and the end of the chunk
+    this->chunk_ = str_snprintf("%x" CRLF_STR, 4 * sizeof(this->batch_.size()) + CRLF_LEN, this->batch_.size());
+    this->chunk_.append(this->batch_);
+    this->chunk_.append(CRLF_STR, CRLF_LEN);
+    this->batch_.clear();
+  }
+
+  // the server logs a warning for every send that would block, so only send what the socket takes
+  if (!this->writable_())
+    return;
+  int sent = httpd_socket_send(this->hd_, this->fd_, this->chunk_.data() + this->chunk_sent_,
+                               this->chunk_.size() - this->chunk_sent_, MSG_DONTWAIT);
+  if (sent > 0) {
+    this->chunk_sent_ += sent;
+  } else if (sent != HTTPD_SOCK_ERR_TIMEOUT) {
+    // the socket is closing, the session goes away with it
+    this->chunk_.clear();
+    this->chunk_sent_ = 0;
+    this->batch_.clear();
+  }
+}
 
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+bool AsyncEventSourceResponse::writable_() const {
+  fd_set write_fds;
+  FD_ZERO(&write_fds);
+  FD_SET(this->fd_, &write_fds);
+  struct timeval timeout = {0, 0};
+  return select(this->fd_ + 1, nullptr, &write_fds, nullptr, &timeout) > 0;
 }
 
 }  // namespace web_server_idf
@@ -9,6 +9,8 @@
 #include <map>
 #include <set>
 
+#include "esphome/core/helpers.h"
+
 namespace esphome {
 namespace web_server_idf {
 
@@ -213,22 +215,50 @@ class AsyncWebHandler {
 
 class AsyncEventSource;
 
+/** A client of an AsyncEventSource.
+ *
+ * Events are collected and sent as one chunk when the source loops, without blocking on the socket. A client that
+ * doesn't keep up loses the events beyond MAX_PENDING_SIZE, and is passed to the resync handler of the source once it
+ * has caught up, so that it gets the latest states again.
+ */
 class AsyncEventSourceResponse {
   friend class AsyncEventSource;
 
  public:
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
+  /// Maximum size of the events waiting for a client.
+  static const size_t MAX_PENDING_SIZE = 8192;
+
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  /// Send as much of the pending events as the socket takes.
+  void flush_();
+  /// Whether the socket takes data without blocking.
+  bool writable_() const;
+
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  /// Events that are waiting for the next chunk.
+  std::string batch_;
+  /// The chunk that is being sent, and how much of it the socket took.
+  std::string chunk_;
+  size_t chunk_sent_{0};
+  /// Events were dropped since the client caught up last.
+  bool overflowed_{false};
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
 
+/** Server-sent events on ESP-IDF.
+ *
+ * Clients connect and disconnect in the HTTP server task, everything else runs in the main loop. New clients wait
+ * until the next loop() before they are handed to the connect handler and get events, and the clients are locked
+ * while events are sent, so that the HTTP server task can't free one in the meantime. The handlers run with the
+ * clients locked, so they must only send to the client they get.
+ */
 class AsyncEventSource : public AsyncWebHandler {
   friend class AsyncEventSourceResponse;
   using connect_handler_t = std::function<void(AsyncEventSourceClient *)>;
@@ -245,13 +275,26 @@ class AsyncEventSource : public AsyncWebHandler {
   void handleRequest(AsyncWebServerRequest *request) override;
   // NOLINTNEXTLINE(readability-identifier-naming)
   void onConnect(connect_handler_t cb) { this->on_connect_ = std::move(cb); }
+  /// Set the handler for clients that lost events and caught up again, to send them the current states.
+  void set_on_resync(connect_handler_t cb) { this->on_resync_ = std::move(cb); }
 
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /// Send an event to one client, returns false if it disconnected.
+  bool send_to(AsyncEventSourceClient *client, const char *message, const char *event = nullptr);
+  /// Hand new clients to the connect handler and send the events of each client as one chunk, call this once per
+  /// loop.
+  void loop();
+  size_t count();
 
  protected:
   std::string url_;
+  /// Clients that connected since the last loop().
+  std::vector<AsyncEventSourceResponse *> new_sessions_;
   std::set<AsyncEventSourceResponse *> sessions_;
+  /// Guards new_sessions_, sessions_ and the clients in them.
+  Mutex sessions_lock_;
   connect_handler_t on_connect_{};
+  connect_handler_t on_resync_{};
 };
 
 class DefaultHeaders {
@@ -2,10 +2,14 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include <algorithm>
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
+#ifdef USE_PROFILER
+#include "esphome/components/profiler/profiler.h"
+#endif
 
 namespace esphome {
 
@@ -27,6 +31,8 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  // components may look entities up while later components are still being set up
+  this->build_entity_index_();
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -35,7 +41,12 @@ void Application::setup() {
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
 
-    component->call();
+    {
+#ifdef USE_PROFILER
+      profiler::ProfileScope profile{component, profiler::PROFILE_SECTION_SETUP};
+#endif
+      component->call();
+    }
     this->scheduler.process_to_add();
     this->feed_wdt();
     if (component->can_proceed())
@@ -63,13 +74,103 @@ void Application::setup() {
   this->schedule_dump_config();
   this->calculate_looping_components_();
 }
+template<typename T> void Application::index_entities_(EntityType type, const std::vector<T *> &entities) {
+  const auto begin = static_cast<uint16_t>(this->entity_index_.size());
+  for (auto *obj : entities)
+    this->entity_index_.push_back(EntityIndexEntry{obj->get_object_id_hash(), obj});
+  // stable, so that lookups still find the first registered of entities with the same key
+  std::stable_sort(this->entity_index_.begin() + begin, this->entity_index_.end(),
+                   [](const EntityIndexEntry &a, const EntityIndexEntry &b) { return a.key < b.key; });
+  this->entity_index_ranges_[type] = EntityIndexRange{begin, static_cast<uint16_t>(this->entity_index_.size())};
+}
+void Application::build_entity_index_() {
+  this->entity_index_.clear();
+#ifdef USE_BINARY_SENSOR
+  this->index_entities_(ENTITY_TYPE_BINARY_SENSOR, this->binary_sensors_);
+#endif
+#ifdef USE_SWITCH
+  this->index_entities_(ENTITY_TYPE_SWITCH, this->switches_);
+#endif
+#ifdef USE_BUTTON
+  this->index_entities_(ENTITY_TYPE_BUTTON, this->buttons_);
+#endif
+#ifdef USE_SENSOR
+  this->index_entities_(ENTITY_TYPE_SENSOR, this->sensors_);
+#endif
+#ifdef USE_TEXT_SENSOR
+  this->index_entities_(ENTITY_TYPE_TEXT_SENSOR, this->text_sensors_);
+#endif
+#ifdef USE_FAN
+  this->index_entities_(ENTITY_TYPE_FAN, this->fans_);
+#endif
+#ifdef USE_COVER
+  this->index_entities_(ENTITY_TYPE_COVER, this->covers_);
+#endif
+#ifdef USE_LIGHT
+  this->index_entities_(ENTITY_TYPE_LIGHT, this->lights_);
+#endif
+#ifdef USE_CLIMATE
+  this->index_entities_(ENTITY_TYPE_CLIMATE, this->climates_);
+#endif
+#ifdef USE_NUMBER
+  this->index_entities_(ENTITY_TYPE_NUMBER, this->numbers_);
+#endif
+#ifdef USE_TEXT
+  this->index_entities_(ENTITY_TYPE_TEXT, this->texts_);
+#endif
+#ifdef USE_SELECT
+  this->index_entities_(ENTITY_TYPE_SELECT, this->selects_);
+#endif
+#ifdef USE_LOCK
+  this->index_entities_(ENTITY_TYPE_LOCK, this->locks_);
+#endif
+#ifdef USE_MEDIA_PLAYER
+  this->index_entities_(ENTITY_TYPE_MEDIA_PLAYER, this->media_players_);
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  this->index_entities_(ENTITY_TYPE_ALARM_CONTROL_PANEL, this->alarm_control_panels_);
+#endif
+  this->entity_index_.shrink_to_fit();
+}
+std::vector<Application::EntityIndexEntry>::iterator Application::entity_index_find_(EntityType type, uint32_t key) {
+  const EntityIndexRange &range = this->entity_index_ranges_[type];
+  return std::lower_bound(this->entity_index_.begin() + range.begin, this->entity_index_.begin() + range.end, key,
+                          [](const EntityIndexEntry &entry, uint32_t value) { return entry.key < value; });
+}
+EntityBase *Application::get_entity_by_key(EntityType type, uint32_t key, bool include_internal) {
+  const auto end = this->entity_index_.begin() + this->entity_index_ranges_[type].end;
+  for (auto it = this->entity_index_find_(type, key); it != end && it->key == key; it++) {
+    if (include_internal || !it->entity->is_internal())
+      return it->entity;
+  }
+  return nullptr;
+}
+EntityBase *Application::get_entity_by_object_id(EntityType type, const std::string &object_id) {
+  const auto end = this->entity_index_.begin() + this->entity_index_ranges_[type].end;
+  const uint32_t key = fnv1_hash(object_id);
+  // the hash only narrows it down
+  for (auto it = this->entity_index_find_(type, key); it != end && it->key == key; it++) {
+    if (it->entity->get_object_id() == object_id)
+      return it->entity;
+  }
+  return nullptr;
+}
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
+
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  this->in_loop_ = true;
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     {
+#ifdef USE_PROFILER
+      profiler::ProfileScope profile{component, profiler::PROFILE_SECTION_LOOP};
+#endif
       WarnIfComponentBlockingGuard guard{component};
       component->call();
     }
@@ -77,6 +178,7 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->in_loop_ = false;
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
@@ -88,12 +190,19 @@ void Application::loop() {
     if (now - this->last_loop_ < this->loop_interval_)
       delay_time = this->loop_interval_ - (now - this->last_loop_);
 
-    uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
-    // next_schedule is max 0.5*delay_time
-    // otherwise interval=0 schedules result in constant looping with almost no sleep
-    next_schedule = std::max(next_schedule, delay_time / 2);
-    delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    if (this->looping_components_active_end_ == 0 && this->max_idle_sleep_ > delay_time &&
+        !this->has_pending_enable_loop_requests_ && this->dump_config_at_ >= this->components_.size()) {
+      // Nothing needs polling, sleep until the next timer (or a wake event)
+      delay_time = this->scheduler.next_schedule_in().value_or(this->max_idle_sleep_);
+      delay_time = std::min(delay_time, this->max_idle_sleep_);
+    } else {
+      uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
+      // next_schedule is max 0.5*delay_time
+      // otherwise interval=0 schedules result in constant looping with almost no sleep
+      next_schedule = std::max(next_schedule, delay_time / 2);
+      delay_time = std::min(next_schedule, delay_time);
+    }
+    this->yield_with_select_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -146,12 +255,102 @@ void Application::run_safe_shutdown_hooks() {
 }
 
 void Application::calculate_looping_components_() {
+  // Components that already disabled their loop (e.g. during setup()) go after the enabled ones
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    if (obj->has_overridden_loop() && obj->is_loop_enabled())
       this->looping_components_.push_back(obj);
   }
+  this->looping_components_active_end_ = this->looping_components_.size();
+  for (auto *obj : this->components_) {
+    if (obj->has_overridden_loop() && !obj->is_loop_enabled())
+      this->looping_components_.push_back(obj);
+  }
+}
+
+void Application::disable_component_loop_(Component *component) {
+  for (uint16_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    if (this->in_loop_ && i <= this->current_loop_index_) {
+      // The component already ran in this iteration. Move the current component into its place, so that the last
+      // enabled component, which has not run yet, takes the current slot and runs next.
+      std::swap(this->looping_components_[i], this->looping_components_[this->current_loop_index_]);
+      i = this->current_loop_index_;
+      this->current_loop_index_--;
+    }
+    // Swap with the last enabled component to keep the enabled part contiguous
+    this->looping_components_active_end_--;
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    return;
+  }
+}
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+void Application::enable_pending_loops_() {
+  // Clear first so that requests made while we are processing are not lost
+  this->has_pending_enable_loop_requests_ = false;
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    component->enable_loop();
+  }
 }
 
+void Application::yield_with_select_(uint32_t delay_ms) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (!this->socket_fds_.empty()) {
+    fd_set ready_fds = this->read_fds_;
+    struct timeval tv;
+    tv.tv_sec = delay_ms / 1000;
+    tv.tv_usec = (delay_ms % 1000) * 1000;
+#ifdef USE_SOCKET_IMPL_LWIP_SOCKETS
+    int ret = lwip_select(this->max_fd_ + 1, &ready_fds, nullptr, nullptr, &tv);
+#else
+    int ret = ::select(this->max_fd_ + 1, &ready_fds, nullptr, nullptr, &tv);
+#endif
+    if (ret >= 0) {
+      yield();
+      return;
+    }
+    // select() failed (e.g. EINTR or a stale fd), fall back to a plain delay
+  }
+#endif
+  delay(delay_ms);
+}
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+void Application::register_socket_fd(int fd) {
+  if (fd < 0 || fd >= FD_SETSIZE) {
+    ESP_LOGW(TAG, "Socket fd %d can't be used as a wake source", fd);
+    return;
+  }
+  this->socket_fds_.push_back(fd);
+  FD_SET(fd, &this->read_fds_);
+  this->max_fd_ = std::max(this->max_fd_, fd);
+}
+void Application::unregister_socket_fd(int fd) {
+  auto it = std::find(this->socket_fds_.begin(), this->socket_fds_.end(), fd);
+  if (it == this->socket_fds_.end())
+    return;
+  this->socket_fds_.erase(it);
+  // a closed fd number may already have been handed out again and registered by someone else
+  if (std::find(this->socket_fds_.begin(), this->socket_fds_.end(), fd) == this->socket_fds_.end())
+    FD_CLR(fd, &this->read_fds_);
+  this->max_fd_ = -1;
+  for (int other : this->socket_fds_)
+    this->max_fd_ = std::max(this->max_fd_, other);
+}
+#endif
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
@@ -9,6 +9,10 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/components/socket/headers.h"
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -57,6 +61,26 @@
 
 namespace esphome {
 
+/// The types of entities the Application keeps. Keys and object IDs are unique per type, not across types.
+enum EntityType : uint8_t {
+  ENTITY_TYPE_BINARY_SENSOR,
+  ENTITY_TYPE_SWITCH,
+  ENTITY_TYPE_BUTTON,
+  ENTITY_TYPE_SENSOR,
+  ENTITY_TYPE_TEXT_SENSOR,
+  ENTITY_TYPE_FAN,
+  ENTITY_TYPE_COVER,
+  ENTITY_TYPE_LIGHT,
+  ENTITY_TYPE_CLIMATE,
+  ENTITY_TYPE_NUMBER,
+  ENTITY_TYPE_TEXT,
+  ENTITY_TYPE_SELECT,
+  ENTITY_TYPE_LOCK,
+  ENTITY_TYPE_MEDIA_PLAYER,
+  ENTITY_TYPE_ALARM_CONTROL_PANEL,
+  ENTITY_TYPE_COUNT,
+};
+
 class Application {
  public:
   void pre_setup(const std::string &name, const std::string &friendly_name, const std::string &area,
@@ -187,6 +211,27 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Set the maximum time the main loop may sleep while no component needs its loop() polled.
+   *
+   * When every looping component has disabled its loop (see Component::disable_loop()), the application sleeps until
+   * the next scheduler deadline or socket wake event, but at most this long. Requests made with
+   * Component::enable_loop_soon_any_context() are picked up when the sleep ends, so this also bounds their latency.
+   *
+   * Defaults to 0, which keeps the sleep bounded by the loop interval like when components are polled.
+   *
+   * @param max_idle_sleep The maximum idle sleep in milliseconds.
+   */
+  void set_max_idle_sleep(uint32_t max_idle_sleep) { this->max_idle_sleep_ = max_idle_sleep; }
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Register a socket file descriptor as a wake source for the main loop.
+   *
+   * While the main loop sleeps, it wakes up as soon as any registered socket becomes readable.
+   */
+  void register_socket_fd(int fd);
+  void unregister_socket_fd(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -199,130 +244,148 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
+  /** Find the entity of \p type with the object ID hash \p key, which is also its key in the native API.
+   *
+   * setup() indexes the entities by key before setting up any component, so lookups are a binary search rather than
+   * a scan over every entity of the type. Entities must be registered and named before setup(), like the generated
+   * code does.
+   *
+   * @return The entity, or nullptr if there is none or it's internal and \p include_internal is false.
+   */
+  EntityBase *get_entity_by_key(EntityType type, uint32_t key, bool include_internal = false);
+  /// Find the entity of \p type with the given object ID through the same index, internal entities included.
+  EntityBase *get_entity_by_object_id(EntityType type, const std::string &object_id);
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<binary_sensor::BinarySensor *>(
+        this->get_entity_by_key(ENTITY_TYPE_BINARY_SENSOR, key, include_internal));
+  }
+  binary_sensor::BinarySensor *get_binary_sensor_by_object_id(const std::string &object_id) {
+    return static_cast<binary_sensor::BinarySensor *>(
+        this->get_entity_by_object_id(ENTITY_TYPE_BINARY_SENSOR, object_id));
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<switch_::Switch *>(this->get_entity_by_key(ENTITY_TYPE_SWITCH, key, include_internal));
+  }
+  switch_::Switch *get_switch_by_object_id(const std::string &object_id) {
+    return static_cast<switch_::Switch *>(this->get_entity_by_object_id(ENTITY_TYPE_SWITCH, object_id));
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<button::Button *>(this->get_entity_by_key(ENTITY_TYPE_BUTTON, key, include_internal));
+  }
+  button::Button *get_button_by_object_id(const std::string &object_id) {
+    return static_cast<button::Button *>(this->get_entity_by_object_id(ENTITY_TYPE_BUTTON, object_id));
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<sensor::Sensor *>(this->get_entity_by_key(ENTITY_TYPE_SENSOR, key, include_internal));
+  }
+  sensor::Sensor *get_sensor_by_object_id(const std::string &object_id) {
+    return static_cast<sensor::Sensor *>(this->get_entity_by_object_id(ENTITY_TYPE_SENSOR, object_id));
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<text_sensor::TextSensor *>(
+        this->get_entity_by_key(ENTITY_TYPE_TEXT_SENSOR, key, include_internal));
+  }
+  text_sensor::TextSensor *get_text_sensor_by_object_id(const std::string &object_id) {
+    return static_cast<text_sensor::TextSensor *>(this->get_entity_by_object_id(ENTITY_TYPE_TEXT_SENSOR, object_id));
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<fan::Fan *>(this->get_entity_by_key(ENTITY_TYPE_FAN, key, include_internal));
+  }
+  fan::Fan *get_fan_by_object_id(const std::string &object_id) {
+    return static_cast<fan::Fan *>(this->get_entity_by_object_id(ENTITY_TYPE_FAN, object_id));
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<cover::Cover *>(this->get_entity_by_key(ENTITY_TYPE_COVER, key, include_internal));
+  }
+  cover::Cover *get_cover_by_object_id(const std::string &object_id) {
+    return static_cast<cover::Cover *>(this->get_entity_by_object_id(ENTITY_TYPE_COVER, object_id));
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<light::LightState *>(this->get_entity_by_key(ENTITY_TYPE_LIGHT, key, include_internal));
+  }
+  light::LightState *get_light_by_object_id(const std::string &object_id) {
+    return static_cast<light::LightState *>(this->get_entity_by_object_id(ENTITY_TYPE_LIGHT, object_id));
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<climate::Climate *>(this->get_entity_by_key(ENTITY_TYPE_CLIMATE, key, include_internal));
+  }
+  climate::Climate *get_climate_by_object_id(const std::string &object_id) {
+    return static_cast<climate::Climate *>(this->get_entity_by_object_id(ENTITY_TYPE_CLIMATE, object_id));
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<number::Number *>(this->get_entity_by_key(ENTITY_TYPE_NUMBER, key, include_internal));
+  }
+  number::Number *get_number_by_object_id(const std::string &object_id) {
+    return static_cast<number::Number *>(this->get_entity_by_object_id(ENTITY_TYPE_NUMBER, object_id));
   }
 #endif
 #ifdef USE_TEXT
   const std::vector<text::Text *> &get_texts() { return this->texts_; }
   text::Text *get_text_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->texts_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<text::Text *>(this->get_entity_by_key(ENTITY_TYPE_TEXT, key, include_internal));
+  }
+  text::Text *get_text_by_object_id(const std::string &object_id) {
+    return static_cast<text::Text *>(this->get_entity_by_object_id(ENTITY_TYPE_TEXT, object_id));
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<select::Select *>(this->get_entity_by_key(ENTITY_TYPE_SELECT, key, include_internal));
+  }
+  select::Select *get_select_by_object_id(const std::string &object_id) {
+    return static_cast<select::Select *>(this->get_entity_by_object_id(ENTITY_TYPE_SELECT, object_id));
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<lock::Lock *>(this->get_entity_by_key(ENTITY_TYPE_LOCK, key, include_internal));
+  }
+  lock::Lock *get_lock_by_object_id(const std::string &object_id) {
+    return static_cast<lock::Lock *>(this->get_entity_by_object_id(ENTITY_TYPE_LOCK, object_id));
   }
 #endif
 #ifdef USE_MEDIA_PLAYER
   const std::vector<media_player::MediaPlayer *> &get_media_players() { return this->media_players_; }
   media_player::MediaPlayer *get_media_player_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->media_players_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<media_player::MediaPlayer *>(
+        this->get_entity_by_key(ENTITY_TYPE_MEDIA_PLAYER, key, include_internal));
+  }
+  media_player::MediaPlayer *get_media_player_by_object_id(const std::string &object_id) {
+    return static_cast<media_player::MediaPlayer *>(this->get_entity_by_object_id(ENTITY_TYPE_MEDIA_PLAYER, object_id));
   }
 #endif
 
@@ -331,10 +394,12 @@ class Application {
     return this->alarm_control_panels_;
   }
   alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->alarm_control_panels_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<alarm_control_panel::AlarmControlPanel *>(
+        this->get_entity_by_key(ENTITY_TYPE_ALARM_CONTROL_PANEL, key, include_internal));
+  }
+  alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_object_id(const std::string &object_id) {
+    return static_cast<alarm_control_panel::AlarmControlPanel *>(
+        this->get_entity_by_object_id(ENTITY_TYPE_ALARM_CONTROL_PANEL, object_id));
   }
 #endif
 
@@ -343,14 +408,49 @@ class Application {
  protected:
   friend Component;
 
+  struct EntityIndexEntry {
+    uint32_t key;
+    EntityBase *entity;
+  };
+  struct EntityIndexRange {
+    uint16_t begin;
+    uint16_t end;
+  };
+
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
 
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
+  void enable_pending_loops_();
+  void yield_with_select_(uint32_t delay_ms);
+
   void feed_wdt_arch_();
 
+  /// Sort the registered entities into entity_index_.
+  void build_entity_index_();
+  template<typename T> void index_entities_(EntityType type, const std::vector<T *> &entities);
+  /// The first entry of \p type with a key not less than \p key.
+  std::vector<EntityIndexEntry>::iterator entity_index_find_(EntityType type, uint32_t key);
+
   std::vector<Component *> components_{};
+  /// Components overriding loop(), those with an enabled loop come first.
   std::vector<Component *> looping_components_{};
+  /// End of the enabled part of looping_components_.
+  uint16_t looping_components_active_end_{0};
+  uint16_t current_loop_index_{0};
+  bool in_loop_{false};
+  volatile bool has_pending_enable_loop_requests_{false};
+  /// All entities, grouped by type and sorted by key within each type.
+  std::vector<EntityIndexEntry> entity_index_{};
+  /// Where the entries of each type are in entity_index_.
+  EntityIndexRange entity_index_ranges_[ENTITY_TYPE_COUNT]{};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  std::vector<int> socket_fds_{};
+  fd_set read_fds_{};
+  int max_fd_{-1};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -406,6 +506,7 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+  uint32_t max_idle_sleep_{0};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
 };
@@ -57,6 +57,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -141,6 +142,27 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() until enable_loop() is called.
+   *
+   * Components that only have work to do after an event (a transition being started, data arriving, an interrupt)
+   * can call this from loop() once they are idle. When no component needs its loop() polled, the application
+   * sleeps until the next scheduled timer or wake event instead of spinning at the loop interval.
+   *
+   * Must only be called from the main loop task.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() after disable_loop(). Must only be called from the main loop task.
+  void enable_loop();
+
+  /** Resume calling loop() after disable_loop(), safe to call from interrupts and other tasks.
+   *
+   * The request is picked up at the start of the next main loop iteration.
+   */
+  void enable_loop_soon_any_context();
+
+  bool is_loop_enabled() const;
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -271,6 +293,7 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  volatile bool pending_enable_loop_{false};  ///< Set by enable_loop_soon_any_context().
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -56,6 +56,7 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_MAX_IDLE_SLEEP = "max_idle_sleep"
 
 
 VALID_INCLUDE_EXTS = {".h", ".hpp", ".tcc", ".ino", ".cpp", ".c"}
@@ -155,6 +156,12 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            # Components are still polled at the loop interval unless they disabled their loop,
+            # stay well below the task watchdog timeout
+            cv.Optional(CONF_MAX_IDLE_SLEEP): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(max=cv.TimePeriod(seconds=2)),
+            ),
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -359,6 +366,9 @@ async def to_code(config):
         )
     )
 
+    if CONF_MAX_IDLE_SLEEP in config:
+        cg.add(cg.App.set_max_idle_sleep(config[CONF_MAX_IDLE_SLEEP]))
+
     CORE.add_job(_add_automations, config)
 
     cg.add_build_flag("-fno-exceptions")
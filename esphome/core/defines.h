@@ -39,9 +39,11 @@
 #define USE_OTA_STATE_CALLBACK
 #define USE_OUTPUT
 #define USE_POWER_SUPPLY
+#define USE_PROFILER
 #define USE_QR_CODE
 #define USE_SELECT
 #define USE_SENSOR
+#define USE_SENSOR_HISTORY
 #define USE_STATUS_LED
 #define USE_SWITCH
 #define USE_TEXT
@@ -71,8 +73,13 @@
 #define USE_ESP32_BLE_CLIENT
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
+#define USE_LOGGER_HISTORY
+#define USE_LOGGER_HISTORY_SIZE 4096  // NOLINT
+#define USE_LOGGER_SERIAL_BINARY
+#define USE_LOGGER_TASK_LOG_BUFFER
 #define USE_IMPROV
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
 #define USE_VOICE_ASSISTANT
@@ -116,10 +123,12 @@
 
 #ifdef USE_LIBRETINY
 #define USE_SOCKET_IMPL_LWIP_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 // Disabled feature flags
@@ -4,8 +4,10 @@
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "esphome/core/optional.h"
@@ -468,18 +470,42 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
+ *
+ * Callbacks are kept in one contiguous list of entries that hold the function invoking the callback next to the
+ * callback itself. Callables that are trivially copyable and fit into two pointers, like the usual lambdas capturing
+ * `this` and one more pointer, are stored inline, so adding them doesn't allocate beyond the list and calling them
+ * is a single indirect call. Other callables, std::function included, are moved to the heap.
  *
  * @tparam Ts The arguments for the callbacks, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
+  CallbackManager() = default;
+  CallbackManager(CallbackManager &&other) noexcept { this->callbacks_.swap(other.callbacks_); }
+  CallbackManager &operator=(CallbackManager &&other) noexcept {
+    // other frees the old callbacks
+    this->callbacks_.swap(other.callbacks_);
+    return *this;
+  }
+  CallbackManager(const CallbackManager &) = delete;
+  CallbackManager &operator=(const CallbackManager &) = delete;
+  ~CallbackManager() {
+    for (auto &cb : this->callbacks_) {
+      if (cb.invoke == &CallbackManager::invoke_heap_)
+        delete *reinterpret_cast<HeapCallback **>(cb.storage);  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+  }
+
   /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  template<typename F> void add(F &&callback) {
+    using Callable = typename std::decay<F>::type;
+    this->add_<Callable>(std::forward<F>(callback), std::integral_constant<bool, fits_inline<Callable>()>{});
+  }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
     for (auto &cb : this->callbacks_)
-      cb(args...);
+      cb.invoke(cb.storage, args...);
   }
   size_t size() const { return this->callbacks_.size(); }
 
@@ -487,7 +513,47 @@ template<typename... Ts> class CallbackManager<void(Ts...)> {
   void operator()(Ts... args) { call(args...); }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  using Invoker = void (*)(void *storage, Ts... args);
+  struct Entry {
+    Invoker invoke;
+    alignas(void *) unsigned char storage[2 * sizeof(void *)];  // NOLINT(modernize-avoid-c-arrays)
+  };
+
+  /// Owner of callables that aren't stored inline.
+  struct HeapCallback {
+    virtual ~HeapCallback() = default;
+    virtual void call(Ts... args) = 0;
+  };
+  template<typename F> struct HeapCallbackImpl : HeapCallback {
+    template<typename U> explicit HeapCallbackImpl(U &&callback) : callback(std::forward<U>(callback)) {}
+    void call(Ts... args) override { this->callback(args...); }
+    F callback;
+  };
+
+  template<typename F> static constexpr bool fits_inline() {
+    return sizeof(F) <= sizeof(Entry::storage) && alignof(F) <= alignof(void *) &&
+           std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value;
+  }
+  template<typename F> static void invoke_inline_(void *storage, Ts... args) {
+    (*reinterpret_cast<F *>(storage))(args...);
+  }
+  static void invoke_heap_(void *storage, Ts... args) { (*reinterpret_cast<HeapCallback **>(storage))->call(args...); }
+
+  template<typename F, typename U> void add_(U &&callback, std::true_type /*inline*/) {
+    Entry entry;
+    new (entry.storage) F(std::forward<U>(callback));
+    entry.invoke = &CallbackManager::invoke_inline_<F>;
+    this->callbacks_.push_back(entry);
+  }
+  template<typename F, typename U> void add_(U &&callback, std::false_type /*inline*/) {
+    Entry entry;
+    HeapCallback *heap = new HeapCallbackImpl<F>(std::forward<U>(callback));  // NOLINT(cppcoreguidelines-owning-memory)
+    std::memcpy(entry.storage, &heap, sizeof(heap));
+    entry.invoke = &CallbackManager::invoke_heap_;
+    this->callbacks_.push_back(entry);
+  }
+
+  std::vector<Entry> callbacks_;
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -526,6 +592,105 @@ template<typename T> class Parented {
   T *parent_{nullptr};
 };
 
+/** Ring buffer of the most recent values, with a capacity that is fixed when it is initialized.
+ *
+ * The storage is allocated once, so unlike with a std::deque, pushing values never allocates or fragments the heap.
+ * Once the buffer is full, every push overwrites the oldest value. Pass an ExternalRAMAllocator to keep the values in
+ * PSRAM.
+ */
+template<typename T, typename Allocator = std::allocator<T>> class FixedRingBuffer {
+  static_assert(std::is_trivially_copyable<T>::value, "FixedRingBuffer only holds trivially copyable values");
+
+ public:
+  FixedRingBuffer() = default;
+  explicit FixedRingBuffer(size_t capacity, const Allocator &allocator = Allocator()) : allocator_(allocator) {
+    this->init(capacity);
+  }
+  FixedRingBuffer(FixedRingBuffer &&other) noexcept { this->swap_(other); }
+  FixedRingBuffer &operator=(FixedRingBuffer &&other) noexcept {
+    // other frees the old storage
+    this->swap_(other);
+    return *this;
+  }
+  FixedRingBuffer(const FixedRingBuffer &) = delete;
+  FixedRingBuffer &operator=(const FixedRingBuffer &) = delete;
+  ~FixedRingBuffer() { this->release_(); }
+
+  /// Allocate room for \p capacity values, dropping the current ones. The capacity is 0 if the allocation failed.
+  void init(size_t capacity) {
+    this->release_();
+    if (capacity != 0)
+      this->data_ = this->allocator_.allocate(capacity);
+    if (this->data_ != nullptr) {
+      std::uninitialized_fill_n(this->data_, capacity, T());
+      this->capacity_ = capacity;
+    }
+    this->clear();
+  }
+  void clear() {
+    this->start_ = 0;
+    this->size_ = 0;
+  }
+
+  /** Append a value, overwriting the oldest one if the buffer is full. The capacity must not be 0.
+   *
+   * @return The index of the value in data(), it stays there until it is overwritten.
+   */
+  size_t push(const T &value) {
+    size_t index = this->start_ + this->size_;
+    if (index >= this->capacity_)
+      index -= this->capacity_;
+    if (this->size_ == this->capacity_) {
+      this->start_ = index + 1 == this->capacity_ ? 0 : index + 1;
+    } else {
+      this->size_++;
+    }
+    this->data_[index] = value;
+    return index;
+  }
+  /// Drop the oldest value. The buffer must not be empty.
+  void pop_front() {
+    this->start_ = this->wrap_(this->start_ + 1);
+    this->size_--;
+  }
+
+  /// The value at position \p i, 0 is the oldest value.
+  const T &operator[](size_t i) const { return this->data_[this->wrap_(this->start_ + i)]; }
+  T &operator[](size_t i) { return this->data_[this->wrap_(this->start_ + i)]; }
+  const T &front() const { return (*this)[0]; }
+  const T &back() const { return (*this)[this->size_ - 1]; }
+
+  size_t size() const { return this->size_; }
+  size_t capacity() const { return this->capacity_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+  /// The underlying storage, in the order the values are stored in rather than the order they were pushed in.
+  const T *data() const { return this->data_; }
+
+ protected:
+  size_t wrap_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+  void release_() {
+    if (this->data_ != nullptr)
+      this->allocator_.deallocate(this->data_, this->capacity_);
+    this->data_ = nullptr;
+    this->capacity_ = 0;
+  }
+  void swap_(FixedRingBuffer &other) {
+    std::swap(this->allocator_, other.allocator_);
+    std::swap(this->data_, other.data_);
+    std::swap(this->capacity_, other.capacity_);
+    std::swap(this->start_, other.start_);
+    std::swap(this->size_, other.size_);
+  }
+
+  Allocator allocator_;
+  T *data_{nullptr};
+  size_t capacity_{0};
+  /// Index of the oldest value in data_.
+  size_t start_{0};
+  size_t size_{0};
+};
+
 /// @}
 
 /// @name System APIs
@@ -1,27 +1,32 @@
 #include "scheduler.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
 #include <algorithm>
 #include <cinttypes>
 
+#ifdef USE_PROFILER
+#include "esphome/components/profiler/profiler.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "scheduler";
 
-static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
-
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
-// A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
-// them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
-// iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
+// A note on locking: the `lock_` lock protects the timing wheel, the ready list, `to_add_`, the name index and the
+// item pool. It must be taken when adding, removing or moving items. Callbacks are only run (and items are only
+// released back to the pool after running) from the loop task, so an item that is currently running is never touched
+// by another context except to set its `remove` flag. Released items hand their callback back to the caller, which
+// destroys it once the lock is no longer held: destroying the captures may run arbitrary code, including code that
+// uses the scheduler.
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
-  const uint32_t now = this->millis_();
+  const uint64_t now = this->millis_();
 
   if (!name.empty())
     this->cancel_timeout(component, name);
@@ -31,23 +36,19 @@ void HOT Scheduler::set_timeout(Component *component, const std::string &name, u
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
+  LockGuard guard{this->lock_};
+  auto *item = this->acquire_item_(component, name, SchedulerItem::TIMEOUT);
   item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
+  item->next_execution = now + timeout;
   item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->push_(item);
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
   return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
-  const uint32_t now = this->millis_();
+  const uint64_t now = this->millis_();
 
   if (!name.empty())
     this->cancel_interval(component, name);
@@ -62,18 +63,13 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
 
   ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
+  LockGuard guard{this->lock_};
+  auto *item = this->acquire_item_(component, name, SchedulerItem::INTERVAL);
   item->interval = interval;
-  item->last_execution = now - offset - interval;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
+  // first execution happens right away, later ones are shifted by the random offset
+  item->next_execution = now - offset;
   item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->push_(item);
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
   return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
@@ -135,230 +131,381 @@ bool HOT Scheduler::cancel_retry(Component *component, const std::string &name)
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
-  if (this->empty_())
+  const uint64_t now = this->millis_();
+  LockGuard guard{this->lock_};
+  if (this->ready_ != nullptr || !this->to_add_.empty())
+    return 0;
+
+  // For each level, the start of its first occupied slot is a lower bound of when an item on it needs attention
+  // (either because it is due, or because it has to be cascaded to a finer level).
+  uint64_t next_time = UINT64_MAX;
+  for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+    const uint16_t occupied = this->wheel_occupied_[level];
+    if (occupied == 0)
+      continue;
+    const uint8_t shift = WHEEL_BITS * level;
+    const uint8_t index = (this->current_tick_ >> shift) & (WHEEL_SLOTS - 1);
+    // rotate the occupancy mask so that bit 0 is the slot of the current tick
+    const uint16_t rotated = (occupied >> index) | (occupied << (WHEEL_SLOTS - index));
+    uint64_t slot_time;
+    if (level == 0) {
+      slot_time = this->current_tick_ + __builtin_ctz(rotated);
+    } else {
+      // Unless the current tick starts the slot (then it is about to be cascaded), the current slot of a coarser
+      // level was already cascaded and anything still on it is a full turn ahead.
+      uint8_t offset = WHEEL_SLOTS;
+      if ((rotated & 1) && (this->current_tick_ & ((uint64_t(1) << shift) - 1)) == 0) {
+        offset = 0;
+      } else if (rotated & ~1) {
+        offset = __builtin_ctz(rotated & ~1);
+      }
+      slot_time = ((this->current_tick_ >> shift) + offset) << shift;
+    }
+    next_time = std::min(next_time, slot_time);
+  }
+
+  if (next_time == UINT64_MAX)
     return {};
-  auto &item = this->items_[0];
-  const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
-  if (next_time < now)
+  if (next_time <= now)
     return 0;
-  return next_time - now;
+  return std::min<uint64_t>(next_time - now, UINT32_MAX);
 }
 void HOT Scheduler::call() {
-  const uint32_t now = this->millis_();
+  const uint64_t now = this->millis_();
   this->process_to_add();
 
+  {
+    LockGuard guard{this->lock_};
+    this->wheel_advance_(now);
+  }
+
 #ifdef ESPHOME_DEBUG_SCHEDULER
-  static uint32_t last_print = 0;
+  static uint64_t last_print = 0;
 
   if (now - last_print > 2000) {
     last_print = now;
-    std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu32, this->items_.size(), now);
-    while (!this->empty_()) {
-      this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      this->lock_.unlock();
-
-      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
-                item->last_execution_major, item->next_execution(), item->next_execution_major());
-
-      old_items.push_back(std::move(item));
+    LockGuard guard{this->lock_};
+    ESP_LOGVV(TAG, "Items: pool=%zu, tick=%" PRIu64 ", now=%" PRIu64, this->pool_.size(), this->current_tick_, now);
+    for (SchedulerItem *item = this->ready_; item != nullptr; item = item->next) {
+      ESP_LOGVV(TAG, "  ready %s '%s' interval=%" PRIu32 " next=%" PRIu64, item->get_type_str(), item->name.c_str(),
+                item->interval, item->next_execution);
     }
-    ESP_LOGVV(TAG, "\n");
-
-    {
-      LockGuard guard{this->lock_};
-      this->items_ = std::move(old_items);
+    for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+      for (uint8_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+        for (SchedulerItem *item = this->wheel_[level][slot]; item != nullptr; item = item->next) {
+          ESP_LOGVV(TAG, "  L%u/%02u %s '%s' interval=%" PRIu32 " next=%" PRIu64, level, slot, item->get_type_str(),
+                    item->name.c_str(), item->interval, item->next_execution);
+        }
+      }
     }
+    ESP_LOGVV(TAG, "\n");
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = this->items_.size();
-  // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-
+  while (true) {
+    // declared before any lock guard, so that the callback of a released item is destroyed after the lock is released
+    std::function<void()> released;
+    SchedulerItem *item;
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
-    }
-
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %" PRIu32 " now: %" PRIu32 " items where %zu now %zu. Please report this",
-               to_remove_was, to_remove_, items_was, items_.size());
-      to_remove_ = 0;
-    }
-  }
-
-  while (!this->empty_()) {
-    // use scoping to indicate visibility of `item` variable
-    {
-      // Don't copy-by value yet
-      auto &item = this->items_[0];
-      if ((now - item->last_execution) < item->interval) {
-        // Not reached timeout yet, done for this call
-        break;
-      }
-      uint8_t major = item->next_execution_major();
-      if (this->millis_major_ - major > 1)
+      item = this->ready_;
+      if (item == nullptr)
         break;
+      item->unlink();
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
-        LockGuard guard{this->lock_};
-        this->pop_raw_();
+        this->index_remove_(item);
+        released = this->release_item_(item);
         continue;
       }
+    }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+    ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " next_execution=%" PRIu64 " (now=%" PRIu64 ")",
+              item->get_type_str(), item->name.c_str(), item->interval, item->next_execution, now);
 #endif
 
-      // Warning: During callback(), a lot of stuff can happen, including:
-      //  - timeouts/intervals get added, potentially invalidating vector pointers
-      //  - timeouts/intervals get cancelled
-      {
-        WarnIfComponentBlockingGuard guard{item->component};
-        item->callback();
-      }
-    }
-
+    // Warning: During callback(), a lot of stuff can happen, including:
+    //  - timeouts/intervals get added
+    //  - timeouts/intervals get cancelled, including this one
     {
-      this->lock_.lock();
-
-      // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
-      // Only pop after function call, this ensures we were reachable
-      // during the function call and know if we were cancelled.
-      this->pop_raw_();
-
-      this->lock_.unlock();
+#ifdef USE_PROFILER
+      profiler::ProfileScope profile{item->component,
+                                     item->type == SchedulerItem::INTERVAL ? profiler::PROFILE_SECTION_INTERVAL
+                                                                           : profiler::PROFILE_SECTION_TIMEOUT,
+                                     item->name.c_str(), item->name_hash};
+#endif
+      WarnIfComponentBlockingGuard guard{item->component};
+      item->callback();
+    }
 
-      if (item->remove) {
-        // We were removed/cancelled in the function call, stop
-        to_remove_--;
-        continue;
-      }
+    LockGuard guard{this->lock_};
+    if (item->remove) {
+      // We were cancelled in the function call and are already gone from the index
+      released = this->release_item_(item);
+      continue;
+    }
 
-      if (item->type == SchedulerItem::INTERVAL) {
-        if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
-        }
-        this->push_(std::move(item));
+    if (item->type == SchedulerItem::INTERVAL) {
+      if (item->interval != 0) {
+        const uint64_t missed = (now - item->next_execution) / item->interval;
+        item->next_execution += (missed + 1) * item->interval;
       }
+      // re-armed intervals go through to_add_ so that an interval of 0 runs once per call()
+      this->to_add_.push_back(item);
+    } else {
+      this->index_remove_(item);
+      released = this->release_item_(item);
     }
   }
 
   this->process_to_add();
 }
 void HOT Scheduler::process_to_add() {
+  std::vector<std::function<void()>> released;
   LockGuard guard{this->lock_};
-  for (auto &it : this->to_add_) {
-    if (it->remove) {
+  if (this->current_tick_ == 0)
+    this->current_tick_ = this->millis_();
+
+  for (auto *item : this->to_add_) {
+    if (item->remove) {
+      released.push_back(this->release_item_(item));
       continue;
     }
 
-    this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->wheel_insert_(item);
   }
   this->to_add_.clear();
 }
-void HOT Scheduler::cleanup_() {
-  while (!this->items_.empty()) {
-    auto &item = this->items_[0];
-    if (!item->remove)
-      return;
-
-    to_remove_--;
-
-    {
-      LockGuard guard{this->lock_};
-      this->pop_raw_();
-    }
-  }
-}
-void HOT Scheduler::pop_raw_() {
-  std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
-  this->items_.pop_back();
-}
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
-  LockGuard guard{this->lock_};
-  this->to_add_.push_back(std::move(item));
-}
 bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
-  // obtain lock because this function iterates and can be called from non-loop task context
+  const uint32_t name_hash = fnv1_hash(name);
+  std::vector<std::function<void()>> released;
+  // obtain lock because this function can be called from non-loop task context
   LockGuard guard{this->lock_};
+  if (this->index_.empty())
+    return false;
+
   bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
-      ret = true;
+  SchedulerItem **it = &this->index_[this->index_bucket_(component, name_hash, type)];
+  while (*it != nullptr) {
+    SchedulerItem *item = *it;
+    if (!item->matches(component, name, name_hash, type)) {
+      it = &item->index_next;
+      continue;
     }
-  }
-  for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
-      ret = true;
+
+    *it = item->index_next;
+    item->index_next = nullptr;
+    this->index_size_--;
+    ret = true;
+
+    if (item->list != nullptr) {
+      // Waiting on the wheel or the ready list, can be recycled right away
+      this->wheel_unlink_(item);
+      released.push_back(this->release_item_(item));
+    } else {
+      // Either in to_add_ or currently running, recycled by whoever owns it
+      item->remove = true;
     }
   }
 
   return ret;
 }
-uint32_t Scheduler::millis_() {
+uint64_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
     ESP_LOGD(TAG, "Incrementing scheduler major");
     this->millis_major_++;
   }
   this->last_millis_ = now;
-  return now;
+  // Biased by one major period so that the random phase offset of intervals never underflows.
+  return ((uint64_t(this->millis_major_) + 1) << 32) | now;
 }
 
-bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
-                                       const std::unique_ptr<SchedulerItem> &b) {
-  // min-heap
-  // return true if *a* will happen after *b*
-  uint32_t a_next_exec = a->next_execution();
-  uint8_t a_next_exec_major = a->next_execution_major();
-  uint32_t b_next_exec = b->next_execution();
-  uint8_t b_next_exec_major = b->next_execution_major();
-
-  if (a_next_exec_major != b_next_exec_major) {
-    // The "major" calculation is quite complicated.
-    // Basically, we need to check if the major value lies in the future or
-    //
-
-    // Here are some cases to think about:
-    // Format: a_major,b_major -> expected result (a-b, b-a)
-    // a=255,b=0 -> false (255, 1)
-    // a=0,b=1 -> false   (255, 1)
-    // a=1,b=0 -> true    (1, 255)
-    // a=0,b=255 -> true  (1, 255)
-
-    uint8_t diff1 = a_next_exec_major - b_next_exec_major;
-    uint8_t diff2 = b_next_exec_major - a_next_exec_major;
-    return diff1 < diff2;
+Scheduler::SchedulerItem *HOT Scheduler::acquire_item_(Component *component, const std::string &name,
+                                                       SchedulerItem::Type type) {
+  SchedulerItem *item = this->free_;
+  if (item != nullptr) {
+    this->free_ = item->next;
+    item->next = nullptr;
+  } else {
+    this->pool_.push_back(make_unique<SchedulerItem>());
+    item = this->pool_.back().get();
   }
 
-  return a_next_exec > b_next_exec;
+  item->component = component;
+  // assign() re-uses the capacity the pooled item already has
+  item->name.assign(name);
+  item->name_hash = fnv1_hash(name);
+  item->type = type;
+  item->remove = false;
+  return item;
+}
+std::function<void()> HOT Scheduler::release_item_(SchedulerItem *item) {
+  // take the captures out now instead of keeping them until the item is re-used
+  std::function<void()> callback;
+  callback.swap(item->callback);
+  item->remove = false;
+  item->next = this->free_;
+  this->free_ = item;
+  return callback;
+}
+void HOT Scheduler::push_(SchedulerItem *item) {
+  this->index_insert_(item);
+  this->to_add_.push_back(item);
+}
+
+size_t HOT Scheduler::index_bucket_(Component *component, uint32_t name_hash, SchedulerItem::Type type) const {
+  uint32_t hash = name_hash ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component) >> 2);
+  hash = (hash ^ type) * 2654435761UL;
+  return (hash ^ (hash >> 16)) & (this->index_.size() - 1);
+}
+void HOT Scheduler::index_insert_(SchedulerItem *item) {
+  if (this->index_.empty()) {
+    this->index_.resize(INITIAL_INDEX_BUCKETS);
+  } else if (this->index_size_ >= this->index_.size() * 2) {
+    // keep chains short: double the bucket count and redistribute
+    std::vector<SchedulerItem *> old_index(this->index_.size() * 2, nullptr);
+    old_index.swap(this->index_);
+    for (auto *chain : old_index) {
+      while (chain != nullptr) {
+        SchedulerItem *next = chain->index_next;
+        auto &bucket = this->index_[this->index_bucket_(chain->component, chain->name_hash, chain->type)];
+        chain->index_next = bucket;
+        bucket = chain;
+        chain = next;
+      }
+    }
+  }
+
+  auto &bucket = this->index_[this->index_bucket_(item->component, item->name_hash, item->type)];
+  item->index_next = bucket;
+  bucket = item;
+  this->index_size_++;
+}
+void HOT Scheduler::index_remove_(SchedulerItem *item) {
+  SchedulerItem **it = &this->index_[this->index_bucket_(item->component, item->name_hash, item->type)];
+  while (*it != nullptr) {
+    if (*it == item) {
+      *it = item->index_next;
+      item->index_next = nullptr;
+      this->index_size_--;
+      return;
+    }
+    it = &(*it)->index_next;
+  }
+}
+
+void HOT Scheduler::wheel_insert_(SchedulerItem *item) {
+  if (item->next_execution < this->current_tick_) {
+    item->link(&this->ready_);
+    return;
+  }
+
+  uint64_t delta = item->next_execution - this->current_tick_;
+  uint8_t level = 0;
+  while (delta >= WHEEL_SLOTS && level < WHEEL_LEVELS - 1) {
+    delta >>= WHEEL_BITS;
+    level++;
+  }
+  const uint8_t shift = WHEEL_BITS * level;
+  uint8_t slot;
+  if (delta >= WHEEL_SLOTS) {
+    // Further away than the wheel can represent (only happens when call() has not run for a very long time): park it
+    // on the last slot of the coarsest level, it gets re-inserted when that slot is cascaded.
+    slot = ((this->current_tick_ >> shift) - 1) & (WHEEL_SLOTS - 1);
+  } else {
+    slot = (item->next_execution >> shift) & (WHEEL_SLOTS - 1);
+  }
+
+  item->link(&this->wheel_[level][slot]);
+  this->wheel_occupied_[level] |= 1 << slot;
+}
+void HOT Scheduler::wheel_unlink_(SchedulerItem *item) {
+  SchedulerItem **list = item->list;
+  item->unlink();
+  if (*list != nullptr || list == &this->ready_)
+    return;
+  const size_t pos = list - &this->wheel_[0][0];
+  this->wheel_occupied_[pos / WHEEL_SLOTS] &= ~(1 << (pos % WHEEL_SLOTS));
+}
+void HOT Scheduler::wheel_cascade_(uint8_t level) {
+  const uint8_t slot = (this->current_tick_ >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+  SchedulerItem *item = this->wheel_[level][slot];
+  this->wheel_[level][slot] = nullptr;
+  this->wheel_occupied_[level] &= ~(1 << slot);
+  while (item != nullptr) {
+    SchedulerItem *next = item->next;
+    item->list = nullptr;
+    this->wheel_insert_(item);
+    item = next;
+  }
+}
+void HOT Scheduler::wheel_advance_(uint64_t now) {
+  while (this->current_tick_ <= now) {
+    const uint8_t index = this->current_tick_ & (WHEEL_SLOTS - 1);
+    if (index == 0) {
+      // cascade every level whose current slot starts at this tick, coarsest first
+      uint8_t top = 1;
+      while (top + 1 < WHEEL_LEVELS && ((this->current_tick_ >> (WHEEL_BITS * top)) & (WHEEL_SLOTS - 1)) == 0)
+        top++;
+      for (uint8_t level = top; level > 0; level--)
+        this->wheel_cascade_(level);
+    }
+
+    // everything in the level 0 slot of this tick is due
+    SchedulerItem **slot = &this->wheel_[0][index];
+    while (*slot != nullptr) {
+      SchedulerItem *item = *slot;
+      item->unlink();
+      item->link(&this->ready_);
+    }
+    this->wheel_occupied_[0] &= ~(1 << index);
+
+    // Skip ahead over ticks that cannot have any work: if the finest occupied level is L, nothing happens before
+    // its next slot boundary.
+    uint8_t level = 0;
+    while (level < WHEEL_LEVELS && this->wheel_occupied_[level] == 0)
+      level++;
+    uint64_t next_tick = now + 1;
+    if (level < WHEEL_LEVELS)
+      next_tick = std::min(next_tick, (this->current_tick_ | ((uint64_t(1) << (WHEEL_BITS * level)) - 1)) + 1);
+    this->current_tick_ = next_tick;
+  }
+}
+
+void HOT Scheduler::SchedulerItem::link(SchedulerItem **head) {
+  this->list = head;
+  this->next = nullptr;
+  if (*head == nullptr) {
+    this->prev = this;
+    *head = this;
+    return;
+  }
+  SchedulerItem *tail = (*head)->prev;
+  tail->next = this;
+  this->prev = tail;
+  (*head)->prev = this;
+}
+void HOT Scheduler::SchedulerItem::unlink() {
+  SchedulerItem **head = this->list;
+  if (*head == this) {
+    *head = this->next;
+    if (this->next != nullptr)
+      this->next->prev = this->prev;
+  } else {
+    this->prev->next = this->next;
+    if (this->next != nullptr) {
+      this->next->prev = this->prev;
+    } else {
+      // we were the tail
+      (*head)->prev = this->prev;
+    }
+  }
+  this->list = nullptr;
+  this->prev = nullptr;
+  this->next = nullptr;
 }
 
 }  // namespace esphome
@@ -10,6 +10,15 @@ namespace esphome {
 
 class Component;
 
+/** Timer scheduler backed by a hierarchical timing wheel.
+ *
+ * Timers live in one of WHEEL_LEVELS levels of WHEEL_SLOTS slots each; level 0 has a resolution of one millisecond
+ * and each following level is WHEEL_SLOTS times coarser. Timers are moved ("cascaded") to finer levels as their
+ * deadline approaches, so inserting, cancelling and firing a timer are all O(1).
+ *
+ * SchedulerItem objects are pooled and recycled, and every item is indexed by (component, hashed name, type) so that
+ * cancelling or replacing a named timer does not scan all pending timers.
+ */
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
@@ -28,29 +37,38 @@ class Scheduler {
   void process_to_add();
 
  protected:
+  static const uint8_t WHEEL_BITS = 4;
+  static const uint8_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+  static const uint8_t WHEEL_LEVELS = 8;
+  static const uint8_t INITIAL_INDEX_BUCKETS = 16;
+
   struct SchedulerItem {
     Component *component;
     std::string name;
-    enum Type { TIMEOUT, INTERVAL } type;
+    uint32_t name_hash;
+    enum Type : uint8_t { TIMEOUT, INTERVAL } type;
+    bool remove;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
-    uint32_t last_execution;
+    uint64_t next_execution;
     std::function<void()> callback;
-    bool remove;
-    uint8_t last_execution_major;
-
-    inline uint32_t next_execution() { return this->last_execution + this->timeout; }
-    inline uint8_t next_execution_major() {
-      uint32_t next_exec = this->next_execution();
-      uint8_t next_exec_major = this->last_execution_major;
-      if (next_exec < this->last_execution)
-        next_exec_major++;
-      return next_exec_major;
+
+    // Intrusive links of the timer list (a wheel slot or the ready list) this item is on. The head's `prev` points to
+    // the tail of the list so that appending is O(1). Pooled items are chained through `next` only.
+    SchedulerItem **list{nullptr};
+    SchedulerItem *prev{nullptr};
+    SchedulerItem *next{nullptr};
+    // Chain in the (component, name, type) index bucket.
+    SchedulerItem *index_next{nullptr};
+
+    void link(SchedulerItem **head);
+    void unlink();
+    bool matches(Component *component, const std::string &name, uint32_t name_hash, Type type) const {
+      return this->component == component && this->name_hash == name_hash && this->type == type && this->name == name;
     }
 
-    static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
     const char *get_type_str() {
       switch (this->type) {
         case SchedulerItem::INTERVAL:
@@ -63,22 +81,38 @@ class Scheduler {
     }
   };
 
-  uint32_t millis_();
-  void cleanup_();
-  void pop_raw_();
-  void push_(std::unique_ptr<SchedulerItem> item);
+  uint64_t millis_();
+  SchedulerItem *acquire_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  /// Return the item to the pool. Its callback is handed back, to be destroyed by the caller without the lock held.
+  std::function<void()> release_item_(SchedulerItem *item);
+  void push_(SchedulerItem *item);
   bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
-  bool empty_() {
-    this->cleanup_();
-    return this->items_.empty();
-  }
+
+  size_t index_bucket_(Component *component, uint32_t name_hash, SchedulerItem::Type type) const;
+  void index_insert_(SchedulerItem *item);
+  void index_remove_(SchedulerItem *item);
+
+  void wheel_insert_(SchedulerItem *item);
+  void wheel_unlink_(SchedulerItem *item);
+  void wheel_cascade_(uint8_t level);
+  void wheel_advance_(uint64_t now);
 
   Mutex lock_;
-  std::vector<std::unique_ptr<SchedulerItem>> items_;
-  std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  SchedulerItem *wheel_[WHEEL_LEVELS][WHEEL_SLOTS]{};
+  uint16_t wheel_occupied_[WHEEL_LEVELS]{};
+  /// The next wheel tick (millisecond) that has not been processed yet.
+  uint64_t current_tick_{0};
+  /// Items whose deadline has passed and that will run in the current (or next) call().
+  SchedulerItem *ready_{nullptr};
+  std::vector<SchedulerItem *> to_add_;
+  std::vector<SchedulerItem *> index_;
+  size_t index_size_{0};
+  /// Recycled items, ready to be handed out by acquire_item_().
+  SchedulerItem *free_{nullptr};
+  /// Owns every item ever allocated; items are never returned to the heap, only to `free_`.
+  std::vector<std::unique_ptr<SchedulerItem>> pool_;
   uint32_t last_millis_{0};
-  uint8_t millis_major_{0};
-  uint32_t to_remove_{0};
+  uint32_t millis_major_{0};
 };
 
 }  // namespace esphome
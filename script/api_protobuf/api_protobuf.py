@@ -182,6 +182,15 @@ class TypeInfo:
 
     encode_func = None
 
+    @property
+    def size_content(self):
+        return f"ProtoSize::{self.size_func}(total_size, {self.number}, this->{self.field_name});"
+
+    @property
+    def size_func(self):
+        # ProtoSize mirrors the encode functions of ProtoWriteBuffer
+        return self.encode_func.replace("encode_", "add_", 1)
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -344,6 +353,17 @@ class MessageType(TypeInfo):
     def decode_length(self):
         return f"value.as_message<{self.cpp_type}>()"
 
+    @property
+    def decode_length_content(self) -> str:
+        # decode straight into the member instead of constructing a temporary message
+        return dedent(
+            f"""\
+        case {self.number}: {{
+          value.decode_to_message(this->{self.field_name});
+          return true;
+        }}"""
+        )
+
     def dump(self, name):
         o = f"{name}.dump_to(out);"
         return o
@@ -363,6 +383,27 @@ class BytesType(TypeInfo):
         return o
 
 
+class StringRefType(TypeInfo):
+    """string/bytes field of a zero_copy message, a view into the receive buffer."""
+
+    cpp_type = "StringRef"
+    default_value = ""
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+    encode_func = "encode_string"
+
+    def dump(self, name):
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
+def create_type_info(field, zero_copy=False):
+    if zero_copy and field.type in (9, 12):
+        return StringRefType(field)
+    return TYPE_INFO[field.type](field)
+
+
 @register_type(13)
 class UInt32Type(TypeInfo):
     cpp_type = "uint32_t"
@@ -450,9 +491,9 @@ class SInt64Type(TypeInfo):
 
 
 class RepeatedTypeInfo(TypeInfo):
-    def __init__(self, field):
+    def __init__(self, field, zero_copy=False):
         super().__init__(field)
-        self._ti = TYPE_INFO[field.type](field)
+        self._ti = create_type_info(field, zero_copy)
 
     @property
     def cpp_type(self):
@@ -481,6 +522,16 @@ class RepeatedTypeInfo(TypeInfo):
 
     @property
     def decode_length_content(self) -> str:
+        if isinstance(self._ti, MessageType):
+            # decode straight into the new element instead of copying a temporary message
+            return dedent(
+                f"""\
+            case {self.number}: {{
+              this->{self.field_name}.emplace_back();
+              value.decode_to_message(this->{self.field_name}.back());
+              return true;
+            }}"""
+            )
         content = self._ti.decode_length
         if content is None:
             return None
@@ -530,6 +581,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += f"}}"
         return o
 
+    @property
+    def size_content(self):
+        o = f"for (const auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  ProtoSize::{self._ti.size_func}(total_size, {self.number}, it, true);\n"
+        o += f"}}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -562,6 +620,12 @@ def build_enum_type(desc):
     return out, cpp
 
 
+def get_opt(desc, opt, default=None):
+    if not desc.options.HasExtension(opt):
+        return default
+    return desc.options.Extensions[opt]
+
+
 def build_message_type(desc):
     public_content = []
     protected_content = []
@@ -570,16 +634,19 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    size = []
     dump = []
 
+    zero_copy = get_opt(desc, pb.zero_copy, False)
     for field in desc.field:
         if field.label == 3:
-            ti = RepeatedTypeInfo(field)
+            ti = RepeatedTypeInfo(field, zero_copy)
         else:
-            ti = TYPE_INFO[field.type](field)
+            ti = create_type_info(field, zero_copy)
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        size.append(ti.size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -592,6 +659,10 @@ def build_message_type(desc):
         if ti.dump_content:
             dump.append(ti.dump_content)
 
+    id_ = get_opt(desc, pb.id)
+    if id_ is not None:
+        public_content.insert(0, f"static constexpr uint16_t MESSAGE_TYPE = {id_};")
+
     cpp = ""
     if decode_varint:
         decode_varint.append("default:\n  return false;")
@@ -646,6 +717,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if size:
+        if len(size) == 1 and len(size[0]) + len(o) + 3 < 120:
+            o += f" {size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -752,12 +835,6 @@ class_name = "APIServerConnectionBase"
 ifdefs = {}
 
 
-def get_opt(desc, opt, default=None):
-    if not desc.options.HasExtension(opt):
-        return default
-    return desc.options.Extensions[opt]
-
-
 def build_service_message_type(mt):
     snake = camel_to_snake(mt.name)
     id_ = get_opt(mt, pb.id)
@@ -0,0 +1,245 @@
+import base64
+import struct
+
+import pytest
+
+from esphome.components.logger import binary_log
+
+RODATA_ADDRESS = 0x3F400000
+ANCHOR_OFFSET = 0x10
+
+
+def _elf(path, strings: bytes, is_64: bool = False, endian: str = "<"):
+    """Write a minimal ELF file with a .rodata section and a symbol table holding the anchor."""
+    rodata = b"\0" * ANCHOR_OFFSET + b"\0" + strings
+    strtab = b"\0" + binary_log.ANCHOR_SYMBOL.encode() + b"\0"
+    anchor = RODATA_ADDRESS + ANCHOR_OFFSET
+    if is_64:
+        symbol = struct.pack(f"{endian}IBBHQQ", 0, 0, 0, 0, 0, 0) + struct.pack(
+            f"{endian}IBBHQQ", 1, 0, 0, 1, anchor, 1
+        )
+        header_size, section_format = 64, f"{endian}IIQQQQIIQQ"
+    else:
+        symbol = struct.pack(f"{endian}IIIBBH", 0, 0, 0, 0, 0, 0) + struct.pack(
+            f"{endian}IIIBBH", 1, anchor, 1, 0, 0, 1
+        )
+        header_size, section_format = 52, f"{endian}IIIIIIIIII"
+
+    data = bytearray(header_size)
+    offsets = []
+    for contents in (rodata, symbol, strtab):
+        offsets.append(len(data))
+        data += contents
+    sections = [
+        (0, 0, 0, 0, 0, 0, 0, 0, 0, 0),
+        (
+            0,
+            1,
+            binary_log.SHF_ALLOC,
+            RODATA_ADDRESS,
+            offsets[0],
+            len(rodata),
+            0,
+            0,
+            1,
+            0,
+        ),
+        (0, binary_log.SHT_SYMTAB, 0, 0, offsets[1], len(symbol), 3, 1, 4, 16),
+        (0, 3, 0, 0, offsets[2], len(strtab), 0, 0, 1, 0),
+    ]
+    shoff = len(data)
+    for section in sections:
+        data += struct.pack(section_format, *section)
+
+    data[0:4] = b"\x7fELF"
+    data[4] = 2 if is_64 else 1
+    data[5] = 1 if endian == "<" else 2
+    shentsize = struct.calcsize(section_format)
+    if is_64:
+        struct.pack_into(f"{endian}Q", data, 0x28, shoff)
+        struct.pack_into(f"{endian}HH", data, 0x3A, shentsize, len(sections))
+    else:
+        struct.pack_into(f"{endian}I", data, 0x20, shoff)
+        struct.pack_into(f"{endian}HH", data, 0x2E, shentsize, len(sections))
+    path.write_bytes(bytes(data))
+    return path
+
+
+def _varint(value: int) -> bytes:
+    out = bytearray()
+    while value > 0x7F:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def _zigzag(value: int) -> bytes:
+    return _varint((value << 1) ^ (value >> 63))
+
+
+def _string(value: str) -> bytes:
+    return _varint(len(value.encode())) + value.encode()
+
+
+def _float64(value: float) -> bytes:
+    return struct.pack("<d", value)
+
+
+def _record(fmt_offset: int, args: bytes, level: int = 5, line: int = 42) -> str:
+    """A record line for the format string at `fmt_offset` behind the anchor, as the device writes it."""
+    data = _varint(level) + _varint(line) + _zigzag(fmt_offset) + _string("test") + args
+    return binary_log.RECORD_MARKER + base64.b64encode(data).decode()
+
+
+@pytest.fixture
+def firmware(tmp_path):
+    """Firmware with the given format strings, returns the strings and the offset of each format."""
+
+    def make(*formats: str):
+        offsets = []
+        strings = b""
+        for fmt in formats:
+            # the anchor itself is an empty string, formats follow it
+            offsets.append(1 + len(strings))
+            strings += fmt.encode() + b"\0"
+        path = _elf(tmp_path / "firmware.elf", strings)
+        return binary_log.FirmwareStrings(str(path)), offsets
+
+    return make
+
+
+@pytest.mark.parametrize(
+    "is_64, endian", ((False, "<"), (False, ">"), (True, "<"), (True, ">"))
+)
+def test_firmware_strings__reads_anchor_and_strings(tmp_path, is_64, endian):
+    path = _elf(tmp_path / "firmware.elf", b"hello %d\0world\0", is_64, endian)
+
+    strings = binary_log.FirmwareStrings(str(path))
+
+    assert strings.anchor == RODATA_ADDRESS + ANCHOR_OFFSET
+    assert strings.string_at(strings.anchor) == ""
+    assert strings.string_at(strings.anchor + 1) == "hello %d"
+    assert strings.string_at(strings.anchor + 10) == "world"
+    assert strings.string_at(RODATA_ADDRESS - 1) is None
+    assert strings.string_at(0) is None
+
+
+def test_firmware_strings__not_an_elf_file(tmp_path):
+    path = tmp_path / "firmware.bin"
+    path.write_bytes(b"\xe9\x03\x02\x20")
+
+    with pytest.raises(ValueError, match="not an ELF file"):
+        binary_log.FirmwareStrings(str(path))
+
+
+def test_firmware_strings__no_anchor(tmp_path):
+    path = _elf(tmp_path / "firmware.elf", b"hello\0")
+    data = path.read_bytes().replace(binary_log.ANCHOR_SYMBOL.encode(), b"x" * 25)
+    path.write_bytes(data)
+
+    with pytest.raises(ValueError, match="not built with binary logging"):
+        binary_log.FirmwareStrings(str(path))
+
+
+@pytest.mark.parametrize(
+    "fmt, args, expected",
+    (
+        ("no arguments", b"", "no arguments"),
+        ("100%%", b"", "100%"),
+        ("%d %i", _zigzag(-12) + _zigzag(34), "-12 34"),
+        (
+            "%ld %lld %zd",
+            _zigzag(-1) + _zigzag(-(2**40)) + _zigzag(7),
+            "-1 -1099511627776 7",
+        ),
+        (
+            "%u %lu %llu",
+            _varint(1) + _varint(2**32) + _varint(2**63),
+            f"1 {2**32} {2**63}",
+        ),
+        ("%hhu %hd", _varint(255) + _zigzag(-3), "255 -3"),
+        (
+            "%x %X %08x",
+            _varint(0xBEEF) + _varint(0xBEEF) + _varint(0xAB),
+            "beef BEEF 000000ab",
+        ),
+        ("%o %#o", _varint(8) + _varint(8), "10 010"),
+        ("%c%c", _varint(ord("o")) + _varint(ord("k")), "ok"),
+        ("%f %.1f", _float64(1.5) + _float64(2.25), "1.500000 2.2"),
+        (
+            "%e %g %G",
+            _float64(1e6) + _float64(0.0001) + _float64(1e20),
+            "1.000000e+06 0.0001 1E+20",
+        ),
+        ("%a", _float64(1.5), (1.5).hex()),
+        ("%s and %s", _string("this") + _string("that"), "this and that"),
+        ("[%-5s] [%5s]", _string("ab") + _string("cd"), "[ab   ] [   cd]"),
+        ("%.2s", _string("abcdef"), "ab"),
+        ("%*d|%-*d", _zigzag(4) + _zigzag(7) + _zigzag(3) + _zigzag(1), "   7|1  "),
+        ("%.*f", _zigzag(3) + _float64(3.14159), "3.142"),
+        ("%p", _varint(0x3FFB0000), "0x3ffb0000"),
+        ("%+d % d", _zigzag(5) + _zigzag(5), "+5  5"),
+        ("ends with a newline\n", b"", "ends with a newline"),
+    ),
+)
+def test_decode_record_line__argument_types(firmware, fmt, args, expected):
+    strings, (offset,) = firmware(fmt)
+
+    line = binary_log.decode_record_line(_record(offset, args), strings)
+
+    assert line == f"\033[0;36m[D][test:042]: {expected}\033[0m"
+
+
+def test_decode_record_line__level_and_line(firmware):
+    strings, (offset,) = firmware("boom")
+
+    line = binary_log.decode_record_line(
+        _record(offset, b"", level=1, line=1234), strings
+    )
+
+    assert line == "\033[1;31m[E][test:1234]: boom\033[0m"
+
+
+def test_decode_record_line__picks_the_format_by_offset(firmware):
+    strings, offsets = firmware("first %d", "second %d")
+
+    assert binary_log.decode_record_line(
+        _record(offsets[1], _zigzag(2)), strings
+    ).endswith("second 2\033[0m")
+    assert binary_log.decode_record_line(
+        _record(offsets[0], _zigzag(1)), strings
+    ).endswith("first 1\033[0m")
+
+
+def test_decode_record_line__truncated_arguments(firmware):
+    strings, (offset,) = firmware("%d %s %d")
+
+    line = binary_log.decode_record_line(_record(offset, _zigzag(1)), strings)
+
+    assert line.endswith(": 1 ...\033[0m")
+
+
+def test_decode_record_line__unknown_format(firmware):
+    strings, _ = firmware("known")
+
+    line = binary_log.decode_record_line(_record(-0x1000, b""), strings)
+
+    unknown = strings.anchor - 0x1000
+    assert line.endswith(f": <unknown format string at 0x{unknown:x}>\033[0m")
+
+
+def test_decode_record_line__invalid_record(firmware):
+    strings, _ = firmware("known")
+
+    line = binary_log.decode_record_line(
+        binary_log.RECORD_MARKER + "not*base64", strings
+    )
+
+    assert line == "<invalid binary log record not*base64>"
+
+
+def test_decode_record_line__text_line(firmware):
+    strings, _ = firmware("known")
+
+    assert binary_log.decode_record_line("[I][app:100]: text", strings) is None
@@ -0,0 +1,180 @@
+import pytest
+
+from esphome.components import sensor
+from esphome.const import CONF_TYPE_ID
+from esphome.core import ID, Lambda
+
+
+def _filter(name, config, manual_id=False):
+    """A filters list entry as validation leaves it."""
+    filter_id = ID(
+        f"{name}_id" if manual_id else None,
+        is_declaration=True,
+        type=sensor.Filter,
+        is_manual=manual_id,
+    )
+    return {name: config, CONF_TYPE_ID: filter_id}
+
+
+@pytest.fixture
+def built(monkeypatch):
+    """Replace building filters with recording which filters end up in which object."""
+
+    async def build_registry_entry(registry, conf):
+        registry_entry, _ = sensor.cg.extract_registry_entry_config(registry, conf)
+        return registry_entry.name
+
+    async def build_fused_filter(configs):
+        return [
+            sensor.cg.extract_registry_entry_config(sensor.FILTER_REGISTRY, conf)[
+                0
+            ].name
+            for conf in configs
+        ]
+
+    monkeypatch.setattr(sensor.cg, "build_registry_entry", build_registry_entry)
+    monkeypatch.setattr(sensor, "build_fused_filter", build_fused_filter)
+
+
+@pytest.mark.asyncio
+async def test_build_filters__fuses_runs_of_stateless_filters(built):
+    config = [
+        _filter("offset", 2.0),
+        _filter("multiply", 1.2),
+        _filter("median", {}),
+        _filter("round", {}),
+        _filter("clamp", {}),
+        _filter("lambda", {}),
+    ]
+
+    actual = await sensor.build_filters(config)
+
+    assert actual == [["offset", "multiply"], "median", ["round", "clamp", "lambda"]]
+
+
+@pytest.mark.asyncio
+async def test_build_filters__single_stateless_filter_is_not_fused(built):
+    config = [_filter("offset", 2.0), _filter("median", {}), _filter("multiply", 1.2)]
+
+    actual = await sensor.build_filters(config)
+
+    assert actual == ["offset", "median", "multiply"]
+
+
+@pytest.mark.asyncio
+async def test_build_filters__filter_with_manual_id_is_not_fused(built):
+    config = [
+        _filter("offset", 2.0, manual_id=True),
+        _filter("multiply", 1.2),
+        _filter("round", {}),
+        _filter("offset", 3.0, manual_id=True),
+        _filter("multiply", 0.5),
+    ]
+
+    actual = await sensor.build_filters(config)
+
+    assert actual == ["offset", ["multiply", "round"], "offset", "multiply"]
+
+
+@pytest.mark.asyncio
+async def test_build_fused_filter__generated_lambda(monkeypatch):
+    monkeypatch.setattr(sensor.cg, "Pvariable", lambda id_, rhs, type_: (id_, rhs))
+    config = [
+        _filter("offset", 2.0),
+        _filter("multiply", 1.2),
+        _filter(
+            "lambda",
+            Lambda("if (x > 100.0f)\n  return {};\nreturn x * 0.5f;"),
+        ),
+        _filter(
+            "calibrate_linear",
+            {
+                "method": "exact",
+                "datapoints": [
+                    {"from": 0.0, "to": 0.0},
+                    {"from": 40.0, "to": 45.0},
+                    {"from": 100.0, "to": 102.5},
+                ],
+            },
+        ),
+        _filter(
+            "clamp",
+            {"min_value": 0.0, "max_value": 100.0, "ignore_out_of_range": False},
+        ),
+        _filter("round", {"accuracy_decimals": 1}),
+    ]
+
+    filter_id, rhs = await sensor.build_fused_filter(config)
+
+    # the benchmark component checks this lambda against the separate filters
+    assert filter_id.id == config[0][CONF_TYPE_ID].id
+    assert str(rhs) == (
+        "sensor::make_fused_filter([=](float x) -> optional<float> {\n"
+        "  x = x + 2.0f;\n"
+        "  x = x * 1.2f;\n"
+        "  {\n"
+        "  const optional<float> result = ([=](float x) -> optional<float> {\n"
+        "    if (x > 100.0f)\n"
+        "      return {};\n"
+        "    return x * 0.5f;\n"
+        "  })(x);\n"
+        "  if (!result.has_value())\n"
+        "  return {};\n"
+        "  x = *result;\n"
+        "  }\n"
+        "  if (x < 40.0f) x = (x * 1.125f) + 0.0f;\n"
+        "  else x = (x * 0.9583333333333334f) + 6.666666666666664f;\n"
+        "  if (std::isfinite(x) && x < 0.0f) x = 0.0f;\n"
+        "  if (std::isfinite(x) && x > 100.0f) x = 100.0f;\n"
+        "  if (std::isfinite(x)) {\n"
+        "  const float accuracy_mult = powf(10.0f, 1);\n"
+        "  x = roundf(accuracy_mult * x) / accuracy_mult;\n"
+        "  }\n"
+        "  return x;\n"
+        "})"
+    )
+
+
+@pytest.mark.asyncio
+@pytest.mark.parametrize(
+    "config, expected",
+    (
+        (
+            {"min_value": 0.0, "max_value": 100.0, "ignore_out_of_range": True},
+            [
+                "if (std::isfinite(x) && x < 0.0f) return {};",
+                "if (std::isfinite(x) && x > 100.0f) return {};",
+            ],
+        ),
+        (
+            {
+                "min_value": float("-inf"),
+                "max_value": 10.0,
+                "ignore_out_of_range": False,
+            },
+            ["if (std::isfinite(x) && x > 10.0f) x = 10.0f;"],
+        ),
+    ),
+)
+async def test_clamp_filter_to_statements(config, expected):
+    assert await sensor.clamp_filter_to_statements(config) == expected
+
+
+@pytest.mark.asyncio
+async def test_calibrate_linear_filter_to_statements__least_squares():
+    config = {
+        "method": "least_squares",
+        "datapoints": [{"from": 0.0, "to": 1.0}, {"from": 1.0, "to": 3.0}],
+    }
+
+    actual = await sensor.calibrate_linear_filter_to_statements(config)
+
+    assert actual == ["x = (x * 2.0f) + 1.0f;"]
+
+
+@pytest.mark.parametrize(
+    "value, expected",
+    ((1.5, "1.5f"), (3, "3.0f"), (float("nan"), "NAN"), (float("-inf"), "-INFINITY")),
+)
+def test_float_literal(value, expected):
+    assert sensor._float_literal(value) == expected